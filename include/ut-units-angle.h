@@ -0,0 +1,302 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+
+namespace ut::detail
+{
+    // Positive value truncated to its leading `bits` significant bits
+    [[nodiscard]] consteval long double truncate_bits( long double value, int bits ) noexcept
+    {
+        const long double top = static_cast<long double>( std::uint64_t(1) << bits );
+        long double scale = 1.0l;
+        while ( value * scale >= top )
+            scale /= 2.0l;
+        while ( value * scale < top / 2.0l )
+            scale *= 2.0l;
+        return static_cast<long double>( static_cast<std::uint64_t>( value * scale ) ) / scale;
+    }
+
+    // 2 pi split into three parts (Cody-Waite). head and middle have half the
+    // mantissa bits so n * head and n * middle are exact for n < 2^(digits/2)
+    // and a - n * 2pi keeps its precision for large n. rounding is 2pi - value.
+    // This derives the parts in long double, which is only used for long
+    // double itself as it may be no wider than double (MSVC).
+    template<std::floating_point T>
+    struct two_pi
+    {
+        static constexpr int split = std::numeric_limits<T>::digits / 2;
+        static constexpr long double exact = 2.0l * std::numbers::pi_v<long double>;
+        static constexpr T head = static_cast<T>( truncate_bits( exact, split ) );
+        static constexpr T middle = static_cast<T>( truncate_bits( exact - head, split ) );
+        static constexpr T tail = static_cast<T>( exact - head - middle );
+        static constexpr T value = static_cast<T>( exact );
+        static constexpr T rounding = static_cast<T>( exact - value );
+        static constexpr T inverse = static_cast<T>( 1.0l / exact );
+        static constexpr T pi = std::numbers::pi_v<T>;
+    };
+
+    // double and float parts of 2pi correctly rounded from its exact value
+    template<>
+    struct two_pi<double>
+    {
+        static constexpr double head = 0x1.921fb5p+2;
+        static constexpr double middle = 0x1.110b46p-24;
+        static constexpr double tail = 0x1.1a62633145c07p-52;
+        static constexpr double value = 0x1.921fb54442d18p+2;
+        static constexpr double rounding = 0x1.1a62633145c07p-52;
+        static constexpr double inverse = 0x1.45f306dc9c883p-3;
+        static constexpr double pi = std::numbers::pi_v<double>;
+    };
+
+    template<>
+    struct two_pi<float>
+    {
+        static constexpr float head = 0x1.92p+2f;
+        static constexpr float middle = 0x1.fb4p-10f;
+        static constexpr float tail = 0x1.4442d2p-22f;
+        static constexpr float value = 0x1.921fb6p+2f;
+        static constexpr float rounding = -0x1.777a5cp-23f;
+        static constexpr float inverse = 0x1.45f306p-3f;
+        static constexpr float pi = std::numbers::pi_v<float>;
+    };
+
+    // value - turns * 2pi
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T reduce_turns( T value, T turns ) noexcept
+    {
+        return ( ( value - turns * two_pi<T>::head ) - turns * two_pi<T>::middle ) - turns * two_pi<T>::tail;
+    }
+
+    // Wrapped to (-pi, pi], the comparison compiles to a select
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T wrap_pi( T value ) noexcept
+    {
+        const T result = reduce_turns( value, std::nearbyint( value * two_pi<T>::inverse ) );
+        return result + ( result <= -two_pi<T>::pi ? two_pi<T>::value : T(0) );
+    }
+
+    // Wrapped to [0, 2pi). nearbyint( x - 0.5 ) vectorises where floor does
+    // not, it can be one turn out at ties which the selects correct.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T wrap_2pi( T value ) noexcept
+    {
+        T result = reduce_turns( value, std::nearbyint( value * two_pi<T>::inverse - T(0.5) ) );
+        result += result < T(0) ? two_pi<T>::value : T(0);
+        return result < two_pi<T>::value ? result : T(0);
+    }
+
+    inline constexpr std::size_t angle_block_size = 256;
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Angle wrapped to (-pi, pi]
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE angle<T> wrap_pi( angle<T> value ) noexcept
+    {
+        return angle<T>{ detail::wrap_pi( value.value ) };
+    }
+
+    // Angle wrapped to [0, 2pi)
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE angle<T> wrap_2pi( angle<T> value ) noexcept
+    {
+        return angle<T>{ detail::wrap_2pi( value.value ) };
+    }
+
+    // Shortest signed rotation from b to a, in (-pi, pi]
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE angle<T> angular_difference( angle<T> a, angle<T> b ) noexcept
+    {
+        return angle<T>{ detail::wrap_pi( a.value - b.value ) };
+    }
+
+    // Batch versions, these vectorise where the target has a vector rounding
+    // instruction (SSE4.1, AVX, NEON). out may alias the input.
+    template<std::floating_point T>
+    void wrap_pi( std::span<const angle<T>> values, std::span<angle<T>> out ) noexcept
+    {
+        assert( out.size() == values.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = detail::wrap_pi( values[i].value );
+    }
+
+    template<std::floating_point T>
+    void wrap_2pi( std::span<const angle<T>> values, std::span<angle<T>> out ) noexcept
+    {
+        assert( out.size() == values.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = detail::wrap_2pi( values[i].value );
+    }
+
+    template<std::floating_point T>
+    void angular_difference( std::span<const angle<T>> a, std::span<const angle<T>> b, std::span<angle<T>> out ) noexcept
+    {
+        assert( a.size() == b.size() && out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = detail::wrap_pi( a[i].value - b[i].value );
+    }
+
+    // Streaming phase unwrapper. Each wrapped input is taken to be within pi of
+    // the previous one, the output is continuous across calls. turns counts the
+    // whole revolutions added, it is integer valued.
+    template<std::floating_point T>
+    struct phase_unwrapper
+    {
+        [[nodiscard]] angle<T> operator()( angle<T> wrapped ) noexcept
+        {
+            if ( started )
+                turns -= std::nearbyint( ( wrapped.value - previous.value ) * detail::two_pi<T>::inverse );
+            started = true;
+            previous = wrapped;
+            return angle<T>{ detail::reduce_turns( wrapped.value, -turns ) };
+        }
+
+        // Unwraps a span. The jumps are found for a block at a time with no loop
+        // carried dependency, only the running sum of turns is sequential.
+        void operator()( std::span<const angle<T>> wrapped, std::span<angle<T>> out ) noexcept
+        {
+            assert( out.size() == wrapped.size() );
+            T jumps[detail::angle_block_size];
+            for ( std::size_t start = 0; start < out.size(); start += detail::angle_block_size )
+            {
+                const std::size_t count = std::min( detail::angle_block_size, out.size() - start );
+                const angle<T>* in = wrapped.data() + start;
+
+                jumps[0] = started ? std::nearbyint( ( in[0].value - previous.value ) * detail::two_pi<T>::inverse ) : T(0);
+                for ( std::size_t i = 1; i < count; i++ )
+                    jumps[i] = std::nearbyint( ( in[i].value - in[i - 1].value ) * detail::two_pi<T>::inverse );
+
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    turns -= jumps[i];
+                    jumps[i] = turns;
+                }
+
+                angle<T>* destination = out.data() + start;
+                for ( std::size_t i = 0; i < count; i++ )
+                    destination[i].value = detail::reduce_turns( in[i].value, -jumps[i] );
+
+                started = true;
+                previous = in[count - 1];
+            }
+        }
+
+        void reset() noexcept
+        {
+            previous = angle<T>{ T(0) };
+            turns = T(0);
+            started = false;
+        }
+
+        angle<T> previous{ T(0) };
+        T turns = T(0);
+        bool started = false;
+    };
+
+    // Integrates an angular rate into a phase which is kept wrapped to
+    // (-pi, pi] with the whole revolutions counted separately, so the wrapped
+    // phase keeps full precision however long it runs. Increments are summed
+    // with Kahan compensation.
+    template<std::floating_point T>
+    struct phase_integrator
+    {
+        angle<T> advance( angular_rate<T> rate, time<T> dt ) noexcept
+        {
+            add( rate.value * dt.value );
+            normalise();
+            return phase;
+        }
+
+        // Advances by each rate in turn, out holds the wrapped phase after each
+        // step. The increments are computed a block at a time.
+        void advance( std::span<const angular_rate<T>> rates, time<T> dt, std::span<angle<T>> out ) noexcept
+        {
+            assert( out.size() == rates.size() );
+            T increments[detail::angle_block_size];
+            for ( std::size_t start = 0; start < out.size(); start += detail::angle_block_size )
+            {
+                const std::size_t count = std::min( detail::angle_block_size, out.size() - start );
+                const angular_rate<T>* in = rates.data() + start;
+                for ( std::size_t i = 0; i < count; i++ )
+                    increments[i] = in[i].value * dt.value;
+
+                angle<T>* destination = out.data() + start;
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    add( increments[i] );
+                    normalise();
+                    destination[i] = phase;
+                }
+            }
+        }
+
+        // Phase including the whole revolutions, loses precision as turns grows
+        [[nodiscard]] angle<T> unwrapped() const noexcept
+        {
+            return angle<T>{ phase.value + turns * detail::two_pi<T>::value };
+        }
+
+        void reset( angle<T> value = angle<T>{ T(0) } ) noexcept
+        {
+            phase = wrap_pi( value );
+            turns = std::nearbyint( ( value.value - phase.value ) * detail::two_pi<T>::inverse );
+            compensation = T(0);
+        }
+
+        angle<T> phase{ T(0) };
+        T turns = T(0);
+        T compensation = T(0);
+
+    private:
+        void add( T increment ) noexcept
+        {
+            const T y = increment - compensation;
+            const T sum = phase.value + y;
+            compensation = ( sum - phase.value ) - y;
+            phase.value = sum;
+        }
+
+        // Moves whole revolutions from the phase into turns. Subtracting 2pi
+        // from a phase just past pi is exact, the rounding of 2pi itself goes
+        // into the compensation.
+        void normalise() noexcept
+        {
+            T whole = std::nearbyint( phase.value * detail::two_pi<T>::inverse );
+            whole += phase.value - whole * detail::two_pi<T>::value <= -detail::two_pi<T>::pi ? T(-1) : T(0);
+            phase.value -= whole * detail::two_pi<T>::value;
+            compensation += whole * detail::two_pi<T>::rounding;
+            turns += whole;
+        }
+    };
+} // end namespace ut
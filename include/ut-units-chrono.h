@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <chrono>
+#include <type_traits>
+
+namespace ut::detail
+{
+    template<typename T>
+    struct is_chrono_duration : std::false_type {};
+
+    template<typename Rep, typename Period>
+    struct is_chrono_duration<std::chrono::duration<Rep,Period>> : std::true_type {};
+
+    template<typename T>
+    concept chrono_duration = is_chrono_duration<T>::value;
+
+    // Conversions multiply by one side of the ratio and divide by the other
+    // rather than multiplying by a folded reciprocal, the single division is
+    // correctly rounded so integral ratios (e.g. std::micro) round trip exactly.
+    template<std::floating_point T, typename Period>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T ticks_to_seconds( T ticks ) noexcept
+    {
+        return ticks * static_cast<T>(Period::num) / static_cast<T>(Period::den);
+    }
+
+    template<std::floating_point T, typename Period>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T seconds_to_ticks( T seconds ) noexcept
+    {
+        return seconds * static_cast<T>(Period::den) / static_cast<T>(Period::num);
+    }
+
+    template<chrono_duration Duration, std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr Duration ticks_to_duration( T ticks ) noexcept
+    {
+        using rep = typename Duration::rep;
+        if constexpr ( std::is_integral_v<rep> )
+        {
+            // integral representations round to nearest, halves away from zero
+            // like std::llround (which is not constexpr), ticks - whole is exact
+            rep whole = static_cast<rep>(ticks);
+            const T fraction = ticks - static_cast<T>(whole);
+            if ( fraction >= T(0.5) )
+                whole++;
+            else if ( fraction <= T(-0.5) )
+                whole--;
+            return Duration( whole );
+        }
+        else
+        {
+            return Duration( static_cast<rep>(ticks) );
+        }
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Converts a std::chrono::duration to a time quantity.
+    template<std::floating_point T, typename Rep, typename Period>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr time<T> from_chrono( std::chrono::duration<Rep,Period> duration ) noexcept
+    {
+        time<T> result;
+        result.value = detail::ticks_to_seconds<T,Period>( static_cast<T>(duration.count()) );
+        return result;
+    }
+
+    // Converts a std::chrono::duration period to the frequency it repeats at.
+    template<std::floating_point T, typename Rep, typename Period>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr frequency<T> frequency_from_chrono( std::chrono::duration<Rep,Period> period ) noexcept
+    {
+        frequency<T> result;
+        result.value = static_cast<T>(Period::den) / ( static_cast<T>(period.count()) * static_cast<T>(Period::num) );
+        return result;
+    }
+
+    // Converts a time quantity to a std::chrono::duration.
+    template<detail::chrono_duration Duration, std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr Duration to_chrono( time<T> quantity ) noexcept
+    {
+        return detail::ticks_to_duration<Duration>( detail::seconds_to_ticks<T,typename Duration::period>( quantity.value ) );
+    }
+
+    // Converts a frequency quantity to the std::chrono::duration of one period.
+    template<detail::chrono_duration Duration, std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr Duration to_chrono( frequency<T> quantity ) noexcept
+    {
+        using period = typename Duration::period;
+        return detail::ticks_to_duration<Duration>( static_cast<T>(period::den) / ( quantity.value * static_cast<T>(period::num) ) );
+    }
+
+    // Measures the time between construction and destruction and writes it
+    // into output. The elapsed time so far is also available with elapsed().
+    template<std::floating_point T = double, typename Clock = std::chrono::steady_clock>
+    struct scoped_timer
+    {
+        explicit scoped_timer( time<T>& result ) noexcept
+            : output( result ), start( Clock::now() )
+        {
+        }
+
+        scoped_timer( const scoped_timer& ) = delete;
+        scoped_timer& operator=( const scoped_timer& ) = delete;
+
+        ~scoped_timer() noexcept
+        {
+            output = elapsed();
+        }
+
+        [[nodiscard]] time<T> elapsed() const noexcept
+        {
+            return from_chrono<T>( Clock::now() - start );
+        }
+
+        time<T>& output;
+        typename Clock::time_point start;
+    };
+}
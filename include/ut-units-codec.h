@@ -0,0 +1,433 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ut
+{
+    enum class codec_mode : std::uint8_t
+    {
+        xor_float = 0,  // lossless, Gorilla XOR of consecutive floating point values
+        quantized = 1   // values rounded to a resolution, delta-of-delta of the integers
+    };
+
+    enum class codec_status
+    {
+        ok,
+        bad_header,             // not a channel stream or an unknown version
+        dimension_mismatch,     // the stream holds a quantity of other dimensions
+        type_mismatch,          // the stream holds another floating point type
+        too_small,              // the output span is smaller than the channel
+        truncated               // the stream ends before all values are decoded
+    };
+
+    // Stream header, stored little endian in front of the bit packed values
+    struct channel_header
+    {
+        static constexpr std::array<std::uint8_t, 4> magic{ 'U', 'T', 'Q', 'C' };
+        static constexpr std::uint8_t version = 1;
+        static constexpr std::size_t size = 4 + 1 + 1 + 1 + 7 + 8 + 8 + 8;
+
+        codec_mode mode;
+        std::uint8_t scalar_bytes;
+        std::array<std::int8_t, 7> dimensions;  // s, m, kg, A, K, mol, cd
+        std::uint64_t count;
+        double resolution;                      // SI, quantized mode only
+        std::uint64_t payload_bytes;
+    };
+} // end namespace ut
+
+namespace ut::detail
+{
+    template<std::floating_point T>
+    using codec_bits = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+    inline void codec_put( std::vector<std::uint8_t>& bytes, std::uint64_t value, int count )
+    {
+        for ( int i = 0; i < count; i++ )
+            bytes.push_back( std::uint8_t( value >> ( 8 * i ) ) );
+    }
+
+    [[nodiscard]] inline std::uint64_t codec_get( const std::uint8_t* bytes, int count ) noexcept
+    {
+        std::uint64_t value = 0;
+        for ( int i = 0; i < count; i++ )
+            value |= std::uint64_t( bytes[i] ) << ( 8 * i );
+        return value;
+    }
+
+    // Most significant bit first writer, whole 64 bit words are flushed big endian
+    struct bit_writer
+    {
+        std::vector<std::uint8_t>& bytes;
+        std::uint64_t buffer = 0;
+        int filled = 0;
+
+        UT_UNITS_CRITICAL_INLINE void write( std::uint64_t value, int count )
+        {
+            if ( count < 64 )
+                value &= ( std::uint64_t(1) << count ) - 1;
+
+            const int space = 64 - filled;
+            if ( count < space )
+            {
+                buffer = ( buffer << count ) | value;
+                filled += count;
+                return;
+            }
+
+            const int rest = count - space;
+            const std::uint64_t word = space == 64 ? value : ( buffer << space ) | ( value >> rest );
+            for ( int i = 56; i >= 0; i -= 8 )
+                bytes.push_back( std::uint8_t( word >> i ) );
+            buffer = rest > 0 ? value & ( ( std::uint64_t(1) << rest ) - 1 ) : 0;
+            filled = rest;
+        }
+
+        void finish()
+        {
+            const std::uint64_t word = filled > 0 ? buffer << ( 64 - filled ) : 0;
+            for ( int i = 0; i < filled; i += 8 )
+                bytes.push_back( std::uint8_t( word >> ( 56 - i ) ) );
+            buffer = 0;
+            filled = 0;
+        }
+    };
+
+    // Reads past the end return zero bits, callers check overrun() once at the end
+    struct bit_reader
+    {
+        std::span<const std::uint8_t> bytes;
+        std::size_t position = 0; // bits
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE std::uint64_t word_at( std::size_t byte ) const noexcept
+        {
+            std::uint64_t word = 0;
+            if ( byte + 8 <= bytes.size() )
+            {
+                for ( int i = 0; i < 8; i++ )
+                    word = ( word << 8 ) | bytes[byte + i];
+            }
+            else
+            {
+                for ( std::size_t i = 0; i < 8; i++ )
+                    word = ( word << 8 ) | ( byte + i < bytes.size() ? bytes[byte + i] : 0 );
+            }
+            return word;
+        }
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE std::uint64_t read( int count ) noexcept
+        {
+            const std::size_t byte = position >> 3;
+            const int shift = int( position & 7 );
+            std::uint64_t word = word_at( byte ) << shift;
+            if ( shift + count > 64 )
+                word |= word_at( byte + 8 ) >> ( 64 - shift );
+            position += std::size_t( count );
+            return count == 64 ? word : word >> ( 64 - count );
+        }
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE bool read_bit() noexcept
+        {
+            const std::size_t byte = position >> 3;
+            const bool bit = byte < bytes.size() && ( ( bytes[byte] >> ( 7 - ( position & 7 ) ) ) & 1 );
+            position++;
+            return bit;
+        }
+
+        [[nodiscard]] bool overrun() const noexcept { return position > bytes.size() * 8; }
+    };
+
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr std::uint64_t zigzag( std::int64_t value ) noexcept
+    {
+        return ( std::uint64_t( value ) << 1 ) ^ std::uint64_t( value >> 63 );
+    }
+
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr std::int64_t unzigzag( std::uint64_t value ) noexcept
+    {
+        return std::int64_t( value >> 1 ) ^ -std::int64_t( value & 1 );
+    }
+
+    template<std::floating_point T>
+    void encode_xor( std::span<const T> values, bit_writer& writer )
+    {
+        using bits_type = codec_bits<T>;
+        constexpr int width = int( sizeof(T) * 8 );
+        constexpr int field = width == 64 ? 6 : 5;
+
+        if ( values.empty() )
+            return;
+
+        bits_type previous = std::bit_cast<bits_type>( values[0] );
+        writer.write( previous, width );
+        int previous_leading = width;
+        int previous_trailing = 0;
+
+        for ( std::size_t i = 1; i < values.size(); i++ )
+        {
+            const bits_type current = std::bit_cast<bits_type>( values[i] );
+            const bits_type difference = current ^ previous;
+            previous = current;
+
+            if ( difference == 0 )
+            {
+                writer.write( 0, 1 );
+                continue;
+            }
+
+            const int leading = std::countl_zero( difference );
+            const int trailing = std::countr_zero( difference );
+            if ( leading >= previous_leading && trailing >= previous_trailing )
+            {
+                // fits in the previous window of meaningful bits
+                writer.write( 0b10, 2 );
+                writer.write( difference >> previous_trailing, width - previous_leading - previous_trailing );
+            }
+            else
+            {
+                const int length = width - leading - trailing;
+                writer.write( 0b11, 2 );
+                writer.write( std::uint64_t( leading ), field );
+                writer.write( std::uint64_t( length - 1 ), field );
+                writer.write( difference >> trailing, length );
+                previous_leading = leading;
+                previous_trailing = trailing;
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    void decode_xor( bit_reader& reader, T* out, std::size_t count ) noexcept
+    {
+        using bits_type = codec_bits<T>;
+        constexpr int width = int( sizeof(T) * 8 );
+        constexpr int field = width == 64 ? 6 : 5;
+
+        if ( count == 0 )
+            return;
+
+        bits_type previous = bits_type( reader.read( width ) );
+        out[0] = std::bit_cast<T>( previous );
+        int leading = 0;
+        int length = width;
+
+        for ( std::size_t i = 1; i < count && !reader.overrun(); i++ )
+        {
+            if ( reader.read_bit() )
+            {
+                if ( reader.read_bit() )
+                {
+                    leading = int( reader.read( field ) );
+                    length = int( reader.read( field ) ) + 1;
+                }
+                previous ^= bits_type( reader.read( length ) ) << ( width - leading - length );
+            }
+            out[i] = std::bit_cast<T>( previous );
+        }
+    }
+
+    // Gorilla style buckets for the zigzagged delta-of-delta
+    UT_UNITS_CRITICAL_INLINE void write_delta_of_delta( bit_writer& writer, std::int64_t value )
+    {
+        const std::uint64_t encoded = zigzag( value );
+        if ( encoded == 0 )
+            writer.write( 0b0, 1 );
+        else if ( encoded < ( std::uint64_t(1) << 7 ) )
+            writer.write( ( 0b10ull << 7 ) | encoded, 9 );
+        else if ( encoded < ( std::uint64_t(1) << 9 ) )
+            writer.write( ( 0b110ull << 9 ) | encoded, 12 );
+        else if ( encoded < ( std::uint64_t(1) << 12 ) )
+            writer.write( ( 0b1110ull << 12 ) | encoded, 16 );
+        else
+        {
+            writer.write( 0b1111, 4 );
+            writer.write( encoded, 64 );
+        }
+    }
+
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE std::int64_t read_delta_of_delta( bit_reader& reader ) noexcept
+    {
+        if ( !reader.read_bit() )
+            return 0;
+        if ( !reader.read_bit() )
+            return unzigzag( reader.read( 7 ) );
+        if ( !reader.read_bit() )
+            return unzigzag( reader.read( 9 ) );
+        if ( !reader.read_bit() )
+            return unzigzag( reader.read( 12 ) );
+        return unzigzag( reader.read( 64 ) );
+    }
+
+    template<std::floating_point T>
+    void encode_quantized( std::span<const T> values, double resolution, bit_writer& writer )
+    {
+        const double inverse = 1.0 / resolution;
+        std::int64_t previous = 0;
+        std::int64_t previous_delta = 0;
+        for ( std::size_t i = 0; i < values.size(); i++ )
+        {
+            assert( std::isfinite( values[i] ) );
+            const std::int64_t current = std::llround( double( values[i] ) * inverse );
+            if ( i == 0 )
+            {
+                writer.write( zigzag( current ), 64 );
+            }
+            else
+            {
+                // wrapping arithmetic, the decoder wraps back
+                const std::int64_t delta = std::int64_t( std::uint64_t( current ) - std::uint64_t( previous ) );
+                write_delta_of_delta( writer, std::int64_t( std::uint64_t( delta ) - std::uint64_t( previous_delta ) ) );
+                previous_delta = delta;
+            }
+            previous = current;
+        }
+    }
+
+    template<std::floating_point T>
+    void decode_quantized( bit_reader& reader, double resolution, T* out, std::size_t count ) noexcept
+    {
+        if ( count == 0 )
+            return;
+
+        std::int64_t current = unzigzag( reader.read( 64 ) );
+        std::int64_t delta = 0;
+        out[0] = T( double( current ) * resolution );
+        for ( std::size_t i = 1; i < count && !reader.overrun(); i++ )
+        {
+            delta = std::int64_t( std::uint64_t( delta ) + std::uint64_t( read_delta_of_delta( reader ) ) );
+            current = std::int64_t( std::uint64_t( current ) + std::uint64_t( delta ) );
+            out[i] = T( double( current ) * resolution );
+        }
+    }
+
+    template<qty_type Qty>
+    void encode_channel( std::span<const Qty> values, codec_mode mode, double resolution, std::vector<std::uint8_t>& stream )
+    {
+        using T = typename Qty::type;
+
+        const std::size_t start = stream.size();
+        stream.insert( stream.end(), channel_header::magic.begin(), channel_header::magic.end() );
+        stream.push_back( channel_header::version );
+        stream.push_back( std::uint8_t( mode ) );
+        stream.push_back( std::uint8_t( sizeof(T) ) );
+        for ( const std::int8_t dimension : dimension_exponents<typename Qty::dimensions>() )
+            stream.push_back( std::uint8_t( dimension ) );
+        codec_put( stream, values.size(), 8 );
+        codec_put( stream, std::bit_cast<std::uint64_t>( resolution ), 8 );
+        codec_put( stream, 0, 8 ); // payload size, patched below
+
+        // qty is layout compatible with its scalar
+        const std::span<const T> scalars( reinterpret_cast<const T*>( values.data() ), values.size() );
+        const std::size_t payload_start = stream.size();
+        bit_writer writer{ stream };
+        if ( mode == codec_mode::quantized )
+            encode_quantized( scalars, resolution, writer );
+        else
+            encode_xor( scalars, writer );
+        writer.finish();
+
+        const std::uint64_t payload = stream.size() - payload_start;
+        for ( int i = 0; i < 8; i++ )
+            stream[start + channel_header::size - 8 + std::size_t( i )] = std::uint8_t( payload >> ( 8 * i ) );
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Reads the header at the front of stream
+    [[nodiscard]] inline codec_status read_channel_header( std::span<const std::uint8_t> stream, channel_header& header ) noexcept
+    {
+        if ( stream.size() < channel_header::size )
+            return codec_status::bad_header;
+        for ( std::size_t i = 0; i < channel_header::magic.size(); i++ )
+            if ( stream[i] != channel_header::magic[i] )
+                return codec_status::bad_header;
+        if ( stream[4] != channel_header::version || stream[5] > std::uint8_t( codec_mode::quantized ) )
+            return codec_status::bad_header;
+
+        header.mode = codec_mode( stream[5] );
+        header.scalar_bytes = stream[6];
+        for ( std::size_t i = 0; i < header.dimensions.size(); i++ )
+            header.dimensions[i] = std::int8_t( stream[7 + i] );
+        header.count = detail::codec_get( stream.data() + 14, 8 );
+        header.resolution = std::bit_cast<double>( detail::codec_get( stream.data() + 22, 8 ) );
+        header.payload_bytes = detail::codec_get( stream.data() + 30, 8 );
+        return codec_status::ok;
+    }
+
+    // Appends a lossless Gorilla XOR encoded channel to stream
+    template<detail::qty_type Qty>
+    void encode_channel( std::span<const Qty> values, std::vector<std::uint8_t>& stream )
+    {
+        detail::encode_channel( values, codec_mode::xor_float, 0.0, stream );
+    }
+
+    // Appends a channel quantized to resolution, e.g. 0.01 * ut::foot. Values are
+    // decoded to within half of resolution, slowly varying channels become mostly
+    // single bit delta-of-deltas.
+    template<detail::qty_type Qty, detail::mixed_qty<Qty> TyResolution>
+    void encode_channel( std::span<const Qty> values, TyResolution resolution, std::vector<std::uint8_t>& stream )
+    {
+        assert( resolution.value > 0 );
+        detail::encode_channel( values, codec_mode::quantized, double( typename Qty::type( resolution.value ) ), stream );
+    }
+
+    // Decodes the channel at the front of stream into out, the dimensions and scalar
+    // type recorded in the header must match Qty. count is set to the number of values.
+    template<detail::qty_type Qty>
+    [[nodiscard]] codec_status decode_channel( std::span<const std::uint8_t> stream, std::span<Qty> out, std::size_t& count ) noexcept
+    {
+        using T = typename Qty::type;
+
+        channel_header header;
+        if ( const codec_status status = read_channel_header( stream, header ); status != codec_status::ok )
+            return status;
+        if ( header.dimensions != detail::dimension_exponents<typename Qty::dimensions>() )
+            return codec_status::dimension_mismatch;
+        if ( header.scalar_bytes != sizeof(T) )
+            return codec_status::type_mismatch;
+        if ( header.count > out.size() )
+            return codec_status::too_small;
+        if ( header.payload_bytes > stream.size() - channel_header::size )
+            return codec_status::truncated;
+
+        detail::bit_reader reader{ stream.subspan( channel_header::size, std::size_t( header.payload_bytes ) ) };
+        T* scalars = reinterpret_cast<T*>( out.data() );
+        count = std::size_t( header.count );
+        if ( header.mode == codec_mode::quantized )
+            detail::decode_quantized( reader, header.resolution, scalars, count );
+        else
+            detail::decode_xor( reader, scalars, count );
+
+        return reader.overrun() ? codec_status::truncated : codec_status::ok;
+    }
+} // end namespace ut
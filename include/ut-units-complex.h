@@ -0,0 +1,404 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include "ut-units-soa.h"
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace ut
+{
+    // Complex valued quantity, e.g. an impedance or a phasor. Stored as two
+    // qty so the real and imaginary parts keep their dimensions. It is not a
+    // qty_type so the real quantity operators and functions do not apply.
+    template<
+        std::floating_point T,
+        detail::qty_dimensions_type TyDimensions = qty_dimensions<>
+    >
+    struct complex_qty
+    {
+        using scalar_type = T;
+        using dimensions = TyDimensions;
+
+        qty<T,dimensions> real;
+        qty<T,dimensions> imag;
+
+        // Both parts in unit, e.g. impedance.in( ut::ohm )
+        template<detail::mixed_qty<qty<T,dimensions>> Ty>
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE std::complex<T> in( const Ty& unit ) const noexcept
+        {
+            return { real.in( unit ), imag.in( unit ) };
+        }
+    };
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    complex_qty( qty<T,dimensions>, qty<T,dimensions> ) -> complex_qty<T,dimensions>;
+
+    template<std::floating_point T> using phasor_voltage    = complex_qty<T,decltype(volt)::dimensions>;
+    template<std::floating_point T> using phasor_current    = complex_qty<T,decltype(ampere)::dimensions>;
+    template<std::floating_point T> using impedance         = complex_qty<T,decltype(ohm)::dimensions>;
+    template<std::floating_point T> using admittance        = complex_qty<T,decltype(1.0 / ohm)::dimensions>;
+    template<std::floating_point T> using complex_power     = complex_qty<T,decltype(watt)::dimensions>;
+} // end namespace ut
+
+namespace ut::detail
+{
+    template<typename T>
+    inline constexpr bool is_complex_qty = false;
+
+    template<std::floating_point T, qty_dimensions_type dimensions>
+    inline constexpr bool is_complex_qty<complex_qty<T,dimensions>> = true;
+
+    template<typename T>
+    concept complex_qty_type = is_complex_qty<T>;
+
+    template<typename T1, typename T2>
+    concept compatible_complex_qty = requires() {
+        requires complex_qty_type<T1>;
+        requires complex_qty_type<T2>;
+        requires std::same_as<typename T1::scalar_type, typename T2::scalar_type>;
+        requires same_dimensions<typename T1::dimensions, typename T2::dimensions>::value;
+    };
+
+    template<std::floating_point T, qty_dimensions_type TyLeft, qty_dimensions_type TyRight>
+    using complex_multiply = complex_qty<T, typename qty_multiply<T,TyLeft,TyRight>::dimensions>;
+
+    template<std::floating_point T, qty_dimensions_type TyLeft, qty_dimensions_type TyRight>
+    using complex_divide = complex_qty<T, typename qty_divide<T,TyLeft,TyRight>::dimensions>;
+} // end namespace ut::detail
+
+namespace ut
+{
+    template<typename TyLeft, typename TyRight>
+    requires( detail::compatible_complex_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr TyLeft operator+( TyLeft left, TyRight right ) noexcept
+    {
+        return { left.real + right.real, left.imag + right.imag };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::compatible_complex_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr TyLeft operator-( TyLeft left, TyRight right ) noexcept
+    {
+        return { left.real - right.real, left.imag - right.imag };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::compatible_complex_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator==( TyLeft left, TyRight right ) noexcept
+    {
+        return left.real.value == right.real.value && left.imag.value == right.imag.value;
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::compatible_complex_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator!=( TyLeft left, TyRight right ) noexcept
+    {
+        return !( left == right );
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr complex_qty<T,dimensions> operator-( complex_qty<T,dimensions> value ) noexcept
+    {
+        return { -value.real, -value.imag };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_multiply<T,TyLeft,TyRight>
+    operator*( complex_qty<T,TyLeft> left, complex_qty<T,TyRight> right ) noexcept
+    {
+        return { left.real * right.real - left.imag * right.imag, left.real * right.imag + left.imag * right.real };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_multiply<T,TyLeft,TyRight>
+    operator*( complex_qty<T,TyLeft> left, qty<T,TyRight> right ) noexcept
+    {
+        return { left.real * right, left.imag * right };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_multiply<T,TyLeft,TyRight>
+    operator*( qty<T,TyLeft> left, complex_qty<T,TyRight> right ) noexcept
+    {
+        return { left * right.real, left * right.imag };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr complex_qty<T,dimensions> operator*( Ty left, complex_qty<T,dimensions> right ) noexcept
+    {
+        return { T(left) * right.real, T(left) * right.imag };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr complex_qty<T,dimensions> operator*( complex_qty<T,dimensions> left, Ty right ) noexcept
+    {
+        return { left.real * T(right), left.imag * T(right) };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_divide<T,TyLeft,TyRight>
+    operator/( complex_qty<T,TyLeft> left, complex_qty<T,TyRight> right ) noexcept
+    {
+        const T denominator = right.real.value * right.real.value + right.imag.value * right.imag.value;
+        detail::complex_divide<T,TyLeft,TyRight> result;
+        result.real.value = ( left.real.value * right.real.value + left.imag.value * right.imag.value ) / denominator;
+        result.imag.value = ( left.imag.value * right.real.value - left.real.value * right.imag.value ) / denominator;
+        return result;
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_divide<T,TyLeft,TyRight>
+    operator/( complex_qty<T,TyLeft> left, qty<T,TyRight> right ) noexcept
+    {
+        return { left.real / right, left.imag / right };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type TyLeft, detail::qty_dimensions_type TyRight>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_divide<T,TyLeft,TyRight>
+    operator/( qty<T,TyLeft> left, complex_qty<T,TyRight> right ) noexcept
+    {
+        return complex_qty<T,TyLeft>{ left, qty<T,TyLeft>{ T(0) } } / right;
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::complex_divide<T,qty_dimensions<>,dimensions> operator/( Ty left, complex_qty<T,dimensions> right ) noexcept
+    {
+        return qty<T,qty_dimensions<>>{ T(left) } / right;
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr complex_qty<T,dimensions> operator/( complex_qty<T,dimensions> left, Ty right ) noexcept
+    {
+        return { left.real / T(right), left.imag / T(right) };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr complex_qty<T,dimensions> conj( complex_qty<T,dimensions> value ) noexcept
+    {
+        return { value.real, -value.imag };
+    }
+
+    // Magnitude, in the dimensions of value
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE qty<T,dimensions> abs( complex_qty<T,dimensions> value ) noexcept
+    {
+        return qty<T,dimensions>{ std::hypot( value.real.value, value.imag.value ) };
+    }
+
+    // Phase in (-pi, pi]
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE angle<T> arg( complex_qty<T,dimensions> value ) noexcept
+    {
+        return angle<T>{ std::atan2( value.imag.value, value.real.value ) };
+    }
+
+    template<std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE complex_qty<T,dimensions> polar( qty<T,dimensions> magnitude, angle<T> phase ) noexcept
+    {
+        return { magnitude * std::cos( phase.value ), magnitude * std::sin( phase.value ) };
+    }
+
+    // Complex quantities in split layout, the real and imaginary parts are separate
+    // contiguous arrays so batch kernels vectorise. Qty may be const.
+    template<typename Qty>
+    requires detail::qty_type<std::remove_const_t<Qty>>
+    struct complex_span
+    {
+        using qty_type = std::remove_const_t<Qty>;
+        using value_type = complex_qty<typename qty_type::type, typename qty_type::dimensions>;
+
+        complex_span( std::span<Qty> real, std::span<Qty> imag ) noexcept : real( real ), imag( imag )
+        {
+            assert( real.size() == imag.size() );
+        }
+
+        template<typename Other>
+        requires std::convertible_to<std::span<Other>, std::span<Qty>>
+        complex_span( const complex_span<Other>& other ) noexcept : real( other.real ), imag( other.imag ) {}
+
+        [[nodiscard]] std::size_t size() const noexcept { return real.size(); }
+        [[nodiscard]] value_type operator[]( std::size_t index ) const noexcept { return { real[index], imag[index] }; }
+
+        void store( std::size_t index, value_type value ) const noexcept
+        {
+            real[index] = value.real;
+            imag[index] = value.imag;
+        }
+
+        std::span<Qty> real;
+        std::span<Qty> imag;
+    };
+
+    // Owning split layout array of complex quantities
+    template<std::floating_point T, detail::qty_dimensions_type dimensions = qty_dimensions<>>
+    struct complex_qty_vector
+    {
+        using value_type = complex_qty<T,dimensions>;
+
+        complex_qty_vector() = default;
+        explicit complex_qty_vector( std::size_t count ) : real( count, qty<T,dimensions>{ T(0) } ), imag( count, qty<T,dimensions>{ T(0) } ) {}
+
+        void push_back( value_type value )
+        {
+            real.push_back( value.real );
+            imag.push_back( value.imag );
+        }
+
+        void resize( std::size_t count )
+        {
+            real.resize( count, qty<T,dimensions>{ T(0) } );
+            imag.resize( count, qty<T,dimensions>{ T(0) } );
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return real.size(); }
+        [[nodiscard]] value_type operator[]( std::size_t index ) const noexcept { return { real[index], imag[index] }; }
+
+        [[nodiscard]] complex_span<qty<T,dimensions>> span() noexcept { return { real, imag }; }
+        [[nodiscard]] complex_span<const qty<T,dimensions>> span() const noexcept { return { real, imag }; }
+
+        detail::soa_column<qty<T,dimensions>> real;
+        detail::soa_column<qty<T,dimensions>> imag;
+    };
+} // end namespace ut
+
+namespace ut::detail
+{
+    template<typename TyResult, typename TyExpected>
+    constexpr void check_complex_output() noexcept
+    {
+        static_assert( same_dimensions<typename TyResult::dimensions, typename TyExpected::dimensions>::value );
+        static_assert( std::same_as<typename TyResult::type, typename TyExpected::type>, "scalar types do not match" );
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Batch kernels over split layout spans, out[i] = a[i] op b[i]
+
+    template<typename A, typename B, typename Out>
+    void add( complex_span<A> a, complex_span<B> b, complex_span<Out> out ) noexcept
+    {
+        detail::check_complex_output<std::remove_const_t<A>, std::remove_const_t<B>>();
+        detail::check_complex_output<Out, std::remove_const_t<A>>();
+        assert( a.size() == b.size() && out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            out.real[i].value = a.real[i].value + b.real[i].value;
+            out.imag[i].value = a.imag[i].value + b.imag[i].value;
+        }
+    }
+
+    template<typename A, typename B, typename Out>
+    void multiply( complex_span<A> a, complex_span<B> b, complex_span<Out> out ) noexcept
+    {
+        using T = typename std::remove_const_t<A>::type;
+        detail::check_complex_output<Out, detail::qty_multiply<T, typename std::remove_const_t<A>::dimensions, typename std::remove_const_t<B>::dimensions>>();
+        assert( a.size() == b.size() && out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            const T ar = a.real[i].value, ai = a.imag[i].value;
+            const T br = b.real[i].value, bi = b.imag[i].value;
+            out.real[i].value = ar * br - ai * bi;
+            out.imag[i].value = ar * bi + ai * br;
+        }
+    }
+
+    // out = a * conj(b), e.g. complex power S = V I*
+    template<typename A, typename B, typename Out>
+    void multiply_conj( complex_span<A> a, complex_span<B> b, complex_span<Out> out ) noexcept
+    {
+        using T = typename std::remove_const_t<A>::type;
+        detail::check_complex_output<Out, detail::qty_multiply<T, typename std::remove_const_t<A>::dimensions, typename std::remove_const_t<B>::dimensions>>();
+        assert( a.size() == b.size() && out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            const T ar = a.real[i].value, ai = a.imag[i].value;
+            const T br = b.real[i].value, bi = b.imag[i].value;
+            out.real[i].value = ar * br + ai * bi;
+            out.imag[i].value = ai * br - ar * bi;
+        }
+    }
+
+    template<typename A, typename B, typename Out>
+    void divide( complex_span<A> a, complex_span<B> b, complex_span<Out> out ) noexcept
+    {
+        using T = typename std::remove_const_t<A>::type;
+        detail::check_complex_output<Out, detail::qty_divide<T, typename std::remove_const_t<A>::dimensions, typename std::remove_const_t<B>::dimensions>>();
+        assert( a.size() == b.size() && out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            const T ar = a.real[i].value, ai = a.imag[i].value;
+            const T br = b.real[i].value, bi = b.imag[i].value;
+            const T inverse = T(1) / ( br * br + bi * bi );
+            out.real[i].value = ( ar * br + ai * bi ) * inverse;
+            out.imag[i].value = ( ai * br - ar * bi ) * inverse;
+        }
+    }
+
+    // Scaled by the larger part like std::hypot so it neither overflows nor
+    // underflows where the scalar abs does not, without the call to hypot
+    template<typename A, typename Out>
+    void abs( complex_span<A> a, std::span<Out> out ) noexcept
+    {
+        using T = typename std::remove_const_t<A>::type;
+        detail::check_complex_output<Out, std::remove_const_t<A>>();
+        assert( out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            const T x = std::abs( a.real[i].value );
+            const T y = std::abs( a.imag[i].value );
+            const T larger = x < y ? y : x;
+            const T smaller = x < y ? x : y;
+            const T ratio = larger > T(0) && larger < std::numeric_limits<T>::infinity() ? smaller / larger : T(0);
+            out[i].value = larger * std::sqrt( T(1) + ratio * ratio );
+        }
+    }
+
+    template<typename A, std::floating_point T>
+    void arg( complex_span<A> a, std::span<angle<T>> out ) noexcept
+    {
+        static_assert( std::same_as<typename std::remove_const_t<A>::type, T>, "scalar types do not match" );
+        assert( out.size() == a.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = std::atan2( a.imag[i].value, a.real[i].value );
+    }
+
+    template<typename Magnitude, std::floating_point T, typename Out>
+    void polar( std::span<Magnitude> magnitude, std::span<const angle<T>> phase, complex_span<Out> out ) noexcept
+    {
+        detail::check_complex_output<Out, std::remove_const_t<Magnitude>>();
+        assert( magnitude.size() == phase.size() && out.size() == magnitude.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+        {
+            out.real[i].value = magnitude[i].value * std::cos( phase[i].value );
+            out.imag[i].value = magnitude[i].value * std::sin( phase[i].value );
+        }
+    }
+} // end namespace ut
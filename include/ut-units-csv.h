@@ -0,0 +1,351 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace ut
+{
+    // A unit recognised as a header suffix, SI = ( value + offset ) * scale
+    struct csv_unit
+    {
+        std::string_view symbol;
+        std::array<std::int8_t,7> dimensions;
+        double scale;
+        double offset;
+    };
+
+    enum class csv_status
+    {
+        ok,
+        bad_header,             // the input is empty
+        unknown_column,         // no header field has the name
+        dimension_mismatch,     // the column unit has other dimensions to the requested quantity
+        bad_number,             // a bound field is not a number
+        missing_field           // a row has fewer fields than the header
+    };
+} // end namespace ut
+
+namespace ut::detail
+{
+    inline constexpr std::size_t csv_block_size = 256;
+
+    [[nodiscard]] constexpr std::string_view csv_trim( std::string_view text ) noexcept
+    {
+        while ( !text.empty() && ( text.front() == ' ' || text.front() == '\t' ) )
+            text.remove_prefix( 1 );
+        while ( !text.empty() && ( text.back() == ' ' || text.back() == '\t' || text.back() == '\r' ) )
+            text.remove_suffix( 1 );
+        return text;
+    }
+
+    // Empty fields are NaN
+    [[nodiscard]] inline bool csv_parse( std::string_view text, double& value ) noexcept
+    {
+        text = csv_trim( text );
+        if ( text.empty() )
+        {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        if ( text.front() == '+' )
+            text.remove_prefix( 1 );
+        const char* end = text.data() + text.size();
+        const auto [ptr, error] = std::from_chars( text.data(), end, value );
+        return error == std::errc{} && ptr == end;
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    template<detail::qty_dimensions_type dimensions>
+    [[nodiscard]] constexpr csv_unit make_csv_unit( std::string_view symbol, qty<double,dimensions> unit ) noexcept
+    {
+        return { symbol, detail::dimension_exponents<dimensions>(), unit.value, 0.0 };
+    }
+
+    template<detail::qty_dimensions_type dimensions>
+    [[nodiscard]] constexpr csv_unit make_csv_unit( std::string_view symbol, qty_offset<double,dimensions> unit ) noexcept
+    {
+        return { symbol, detail::dimension_exponents<dimensions>(), unit.value, unit.offset };
+    }
+
+    // Header suffixes recognised by default, the sym:: symbols and a few common extras
+    inline constexpr std::array csv_default_units{
+        make_csv_unit( "s", sym::s ),       make_csv_unit( "m", sym::m ),       make_csv_unit( "kg", sym::kg ),
+        make_csv_unit( "A", sym::A ),       make_csv_unit( "K", sym::K ),       make_csv_unit( "mol", sym::mol ),
+        make_csv_unit( "cd", sym::cd ),     make_csv_unit( "rad", sym::rad ),   make_csv_unit( "Hz", sym::Hz ),
+        make_csv_unit( "N", sym::N ),       make_csv_unit( "pa", sym::pa ),     make_csv_unit( "j", sym::j ),
+        make_csv_unit( "W", sym::W ),       make_csv_unit( "kW", sym::kW ),     make_csv_unit( "kWH", sym::kWH ),
+        make_csv_unit( "C", sym::C ),       make_csv_unit( "V", sym::V ),       make_csv_unit( "F", sym::F ),
+        make_csv_unit( "mm", sym::mm ),     make_csv_unit( "km", sym::km ),     make_csv_unit( "degC", sym::degC ),
+        make_csv_unit( "kgps", sym::kgps ), make_csv_unit( "kgpm3", sym::kgpm3 ), make_csv_unit( "m2", sym::m2 ),
+        make_csv_unit( "L", sym::L ),       make_csv_unit( "deg", sym::deg ),   make_csv_unit( "degps", sym::degps ),
+        make_csv_unit( "radps", sym::radps ), make_csv_unit( "rps", sym::rps ), make_csv_unit( "rpm", sym::rpm ),
+        make_csv_unit( "kgm2", sym::kgm2 ), make_csv_unit( "nmi", sym::nmi ),   make_csv_unit( "ft", sym::ft ),
+        make_csv_unit( "mi", sym::mi ),     make_csv_unit( "yd", sym::yd ),     make_csv_unit( "lb", sym::lb ),
+        make_csv_unit( "lbf", sym::lbf ),   make_csv_unit( "gal", sym::gal ),   make_csv_unit( "qt", sym::qt ),
+        make_csv_unit( "kt", sym::kt ),     make_csv_unit( "psi", sym::psi ),   make_csv_unit( "fps", sym::fps ),
+        make_csv_unit( "degF", sym::degF ), make_csv_unit( "pph", sym::pph ),
+
+        make_csv_unit( "min", ut::minute ), make_csv_unit( "h", ut::hour ),     make_csv_unit( "cm", ut::centimetre ),
+        make_csv_unit( "g", ut::gram ),     make_csv_unit( "Pa", ut::pascal ),  make_csv_unit( "mbar", ut::millibar ),
+        make_csv_unit( "hPa", ut::millibar ), make_csv_unit( "in", ut::inch ),  make_csv_unit( "ohm", ut::ohm ),
+        make_csv_unit( "Wh", ut::watt_hour ), make_csv_unit( "rev", ut::revolution ), make_csv_unit( "mps", ut::metre_per_second )
+    };
+
+    // A header field, "alt_ft" has name "alt" and the unit ft. Fields without a
+    // known unit suffix keep their whole text as the name and are dimensionless.
+    struct csv_field
+    {
+        std::string header;
+        std::string name;
+        csv_unit unit{};
+
+        // set by csv_reader::bind
+        void* target = nullptr;
+        void (*append)( void* target, const double* values, std::size_t count ) = nullptr;
+        std::vector<double> pending;
+    };
+
+    // Streaming reader for numeric delimited text with units in the header.
+    // read() resumes where it stopped, also after the end of a stream which
+    // has grown since.
+    // Bound fields are parsed with std::from_chars and scaled to SI in one
+    // pass, unbound fields are skipped without parsing. Quoted fields are not
+    // supported.
+    struct csv_reader
+    {
+        explicit csv_reader( std::istream& input, char delimiter = ',' ) :
+            input( &input ), delimiter( delimiter ), units( csv_default_units.begin(), csv_default_units.end() ) {}
+
+        // Adds a header suffix, symbol must outlive the reader. Call before read_header.
+        template<detail::qty_dimensions_type dimensions>
+        void add_unit( std::string_view symbol, qty<double,dimensions> unit ) { units.push_back( make_csv_unit( symbol, unit ) ); }
+
+        template<detail::qty_dimensions_type dimensions>
+        void add_unit( std::string_view symbol, qty_offset<double,dimensions> unit ) { units.push_back( make_csv_unit( symbol, unit ) ); }
+
+        // Reads the first line as the header
+        [[nodiscard]] csv_status read_header()
+        {
+            std::string_view text;
+            if ( !next_line( text ) )
+                return csv_status::bad_header;
+            line++;
+
+            fields.clear();
+            std::size_t start = 0;
+            while ( start <= text.size() )
+            {
+                std::size_t stop = text.find( delimiter, start );
+                if ( stop == std::string_view::npos )
+                    stop = text.size();
+                add_field( text.substr( start, stop - start ) );
+                start = stop + 1;
+            }
+            return csv_status::ok;
+        }
+
+        // Appends the field called name ("alt") or with header text name ("alt_ft")
+        // to column, a container of qty with push_back. The field unit must have
+        // the dimensions of the qty.
+        template<typename Container>
+        requires detail::qty_type<typename Container::value_type>
+        [[nodiscard]] csv_status bind( std::string_view name, Container& column )
+        {
+            using Qty = typename Container::value_type;
+            for ( csv_field& field : fields )
+            {
+                if ( field.name != name && field.header != name )
+                    continue;
+                if ( field.unit.dimensions != detail::dimension_exponents<typename Qty::dimensions>() )
+                    return csv_status::dimension_mismatch;
+
+                field.target = &column;
+                field.append = []( void* target, const double* values, std::size_t count ) {
+                    Container& out = *static_cast<Container*>( target );
+                    for ( std::size_t i = 0; i < count; i++ )
+                    {
+                        Qty value;
+                        value.value = static_cast<typename Qty::type>( values[i] );
+                        out.push_back( value );
+                    }
+                };
+                field.pending.resize( detail::csv_block_size );
+                return csv_status::ok;
+            }
+            return csv_status::unknown_column;
+        }
+
+        // Reads up to max_rows rows, stopping at the end of the input or the
+        // first bad row. Rows before a bad row are kept, `line` is the line of the
+        // last row read. Empty lines are skipped.
+        [[nodiscard]] csv_status read( std::size_t max_rows = std::numeric_limits<std::size_t>::max() )
+        {
+            std::size_t last_bound = 0;
+            for ( std::size_t i = 0; i < fields.size(); i++ )
+                if ( fields[i].target )
+                    last_bound = i + 1;
+
+            csv_status status = csv_status::ok;
+            std::string_view text;
+            for ( std::size_t count = 0; count < max_rows && next_line( text ); )
+            {
+                line++;
+                if ( detail::csv_trim( text ).empty() )
+                    continue;
+                status = parse_row( text, last_bound );
+                if ( status != csv_status::ok )
+                    break;
+
+                count++;
+                rows++;
+                if ( ++pending_rows == detail::csv_block_size )
+                    flush();
+            }
+            flush();
+            return status;
+        }
+
+        std::istream* input;
+        char delimiter;
+        std::vector<csv_unit> units;
+        std::vector<csv_field> fields;
+        std::size_t rows = 0;
+        std::size_t line = 0;
+        std::size_t chunk_size = std::size_t(1) << 20;
+
+        std::string buffer;
+        std::size_t position = 0;
+        std::size_t pending_rows = 0;
+        bool end_of_input = false;
+
+    private:
+        void add_field( std::string_view text )
+        {
+            text = detail::csv_trim( text );
+            if ( text.size() >= 2 && text.front() == '"' && text.back() == '"' )
+                text = text.substr( 1, text.size() - 2 );
+
+            csv_field field;
+            field.header = std::string( text );
+            field.name = field.header;
+            field.unit = make_csv_unit( "", ut::one );
+            const std::size_t split = text.rfind( '_' );
+            if ( split != std::string_view::npos )
+            {
+                const std::string_view suffix = text.substr( split + 1 );
+                for ( const csv_unit& unit : units )
+                {
+                    if ( unit.symbol == suffix )
+                    {
+                        field.name = std::string( text.substr( 0, split ) );
+                        field.unit = unit;
+                        break;
+                    }
+                }
+            }
+            fields.push_back( std::move( field ) );
+        }
+
+        [[nodiscard]] csv_status parse_row( std::string_view text, std::size_t last_bound ) noexcept
+        {
+            std::size_t start = 0;
+            for ( std::size_t i = 0; i < last_bound; i++ )
+            {
+                if ( start > text.size() )
+                    return csv_status::missing_field;
+                const char* found = static_cast<const char*>( std::memchr( text.data() + start, delimiter, text.size() - start ) );
+                const std::size_t stop = found ? std::size_t( found - text.data() ) : text.size();
+
+                csv_field& field = fields[i];
+                if ( field.target )
+                {
+                    double value;
+                    if ( !detail::csv_parse( text.substr( start, stop - start ), value ) )
+                        return csv_status::bad_number;
+                    field.pending[pending_rows] = ( value + field.unit.offset ) * field.unit.scale;
+                }
+                start = stop + 1;
+            }
+            return csv_status::ok;
+        }
+
+        void flush()
+        {
+            for ( csv_field& field : fields )
+                if ( field.target && pending_rows > 0 )
+                    field.append( field.target, field.pending.data(), pending_rows );
+            pending_rows = 0;
+        }
+
+        // The next line without its terminator, valid until the next call
+        bool next_line( std::string_view& text )
+        {
+            for ( ;; )
+            {
+                const char* begin = buffer.data() + position;
+                const std::size_t available = buffer.size() - position;
+                const char* newline = static_cast<const char*>( std::memchr( begin, '\n', available ) );
+                if ( newline )
+                {
+                    text = std::string_view( begin, std::size_t( newline - begin ) );
+                    position += text.size() + 1;
+                    return true;
+                }
+                if ( end_of_input )
+                {
+                    // the next call reads again, a growing stream may have more
+                    end_of_input = false;
+                    if ( available == 0 )
+                        return false;
+                    text = std::string_view( begin, available );
+                    position = buffer.size();
+                    return true;
+                }
+
+                buffer.erase( 0, position );
+                position = 0;
+                input->clear();
+                const std::size_t size = buffer.size();
+                buffer.resize( size + chunk_size );
+                input->read( buffer.data() + size, std::streamsize( chunk_size ) );
+                const std::size_t count = std::size_t( input->gcount() );
+                buffer.resize( size + count );
+                end_of_input = count < chunk_size;
+            }
+        }
+    };
+} // end namespace ut
@@ -0,0 +1,231 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace ut::detail
+{
+    // Expressions are built from spans of quantities (leaves), broadcast
+    // quantities/scalars and the usual operators. Nothing is evaluated until
+    // the expression is assigned to a lazy span at which point every element
+    // is computed in one loop with no temporaries.
+    template<typename T>
+    concept qty_expression = requires() {
+        requires std::remove_cvref_t<T>::is_qty_expression;
+    };
+
+    template<typename T>
+    concept broadcastable = qty_type<T> || std::floating_point<T>;
+
+    // Size of expressions which do not have one (broadcast values)
+    inline constexpr std::size_t broadcast_size = std::numeric_limits<std::size_t>::max();
+
+    template<typename Value>
+    struct broadcast_expression
+    {
+        using value_type = Value;
+        static constexpr bool is_qty_expression = true;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr value_type operator[]( std::size_t ) const noexcept { return value; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return broadcast_size; }
+
+        Value value;
+    };
+
+    template<typename Op, qty_expression TyLeft, qty_expression TyRight>
+    struct binary_expression
+    {
+        static constexpr bool is_qty_expression = true;
+
+        // The result type comes from the qty operators themselves so the
+        // usual dimension algebra (qty_multiply, qty_divide) and constraints apply.
+        using value_type = decltype( Op{}( std::declval<typename TyLeft::value_type>(), std::declval<typename TyRight::value_type>() ) );
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr value_type operator[]( std::size_t i ) const noexcept
+        {
+            return Op{}( left[i], right[i] );
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+            return left.size() == broadcast_size ? right.size() : left.size();
+        }
+
+        TyLeft left;
+        TyRight right;
+    };
+
+    template<qty_expression TyOperand>
+    struct negate_expression
+    {
+        using value_type = typename TyOperand::value_type;
+        static constexpr bool is_qty_expression = true;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr value_type operator[]( std::size_t i ) const noexcept { return -operand[i]; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return operand.size(); }
+
+        TyOperand operand;
+    };
+
+    template<typename T>
+    [[nodiscard]] constexpr auto as_expression( const T& value ) noexcept
+    {
+        if constexpr ( qty_expression<T> )
+            return value;
+        else
+            return broadcast_expression<T>{ .value = value };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    concept expression_operands =
+        ( qty_expression<TyLeft> && ( qty_expression<TyRight> || broadcastable<TyRight> ) ) ||
+        ( broadcastable<TyLeft> && qty_expression<TyRight> );
+
+    template<typename Op, typename TyLeft, typename TyRight>
+    using binary_expression_for = binary_expression<
+        Op,
+        decltype( as_expression( std::declval<TyLeft>() ) ),
+        decltype( as_expression( std::declval<TyRight>() ) )
+    >;
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Leaf expression over a span of quantities. Assigning an expression to a
+    // non-const lazy span evaluates it element by element in a single loop.
+    template<typename Qty>
+    requires( detail::qty_type<std::remove_const_t<Qty>> )
+    struct lazy_span
+    {
+        using value_type = std::remove_const_t<Qty>;
+        static constexpr bool is_qty_expression = true;
+
+        constexpr explicit lazy_span( std::span<Qty> span ) noexcept : values( span ) {}
+        constexpr lazy_span( const lazy_span& ) noexcept = default;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr value_type operator[]( std::size_t i ) const noexcept { return values[i]; }
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return values.size(); }
+
+        // Assigning one lazy span to another copies the elements, not the view.
+        lazy_span& operator=( const lazy_span& other ) noexcept requires( ! std::is_const_v<Qty> )
+        {
+            return this->operator=<lazy_span>( other );
+        }
+
+        template<detail::qty_expression TyExpression>
+        lazy_span& operator=( const TyExpression& expression ) noexcept requires( ! std::is_const_v<Qty> )
+        {
+            check<TyExpression>( expression );
+            const std::size_t count = values.size();
+            Qty* out = values.data();
+            for ( std::size_t i = 0; i < count; i++ )
+                out[i] = expression[i];
+            return *this;
+        }
+
+        template<detail::qty_expression TyExpression>
+        lazy_span& operator+=( const TyExpression& expression ) noexcept requires( ! std::is_const_v<Qty> )
+        {
+            check<TyExpression>( expression );
+            const std::size_t count = values.size();
+            Qty* out = values.data();
+            for ( std::size_t i = 0; i < count; i++ )
+                out[i] += expression[i];
+            return *this;
+        }
+
+        template<detail::qty_expression TyExpression>
+        lazy_span& operator-=( const TyExpression& expression ) noexcept requires( ! std::is_const_v<Qty> )
+        {
+            check<TyExpression>( expression );
+            const std::size_t count = values.size();
+            Qty* out = values.data();
+            for ( std::size_t i = 0; i < count; i++ )
+                out[i] -= expression[i];
+            return *this;
+        }
+
+        std::span<Qty> values;
+
+    private:
+        template<typename TyExpression>
+        void check( [[maybe_unused]] const TyExpression& expression ) const noexcept
+        {
+            using result = typename TyExpression::value_type;
+            static_assert( detail::qty_type<result>, "expression does not produce a quantity" );
+            static_assert( detail::same_dimensions<typename result::dimensions, typename value_type::dimensions>::value, "dimensions do not match" );
+            static_assert( std::same_as<typename result::type, typename value_type::type>, "scalar types do not match" );
+            assert( expression.size() == detail::broadcast_size || expression.size() == values.size() );
+        }
+    };
+
+    // Wraps a contiguous range of quantities (std::vector, std::array, std::span, ...)
+    template<std::ranges::contiguous_range TyRange>
+    [[nodiscard]] constexpr auto lazy( TyRange&& range ) noexcept
+    {
+        using element = std::remove_reference_t<std::ranges::range_reference_t<TyRange>>;
+        return lazy_span<element>( std::span<element>( range ) );
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::expression_operands<TyLeft,TyRight> )
+    [[nodiscard]] constexpr auto operator+( const TyLeft& left, const TyRight& right ) noexcept
+    {
+        return detail::binary_expression_for<std::plus<>,TyLeft,TyRight>{ .left = detail::as_expression(left), .right = detail::as_expression(right) };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::expression_operands<TyLeft,TyRight> )
+    [[nodiscard]] constexpr auto operator-( const TyLeft& left, const TyRight& right ) noexcept
+    {
+        return detail::binary_expression_for<std::minus<>,TyLeft,TyRight>{ .left = detail::as_expression(left), .right = detail::as_expression(right) };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::expression_operands<TyLeft,TyRight> )
+    [[nodiscard]] constexpr auto operator*( const TyLeft& left, const TyRight& right ) noexcept
+    {
+        return detail::binary_expression_for<std::multiplies<>,TyLeft,TyRight>{ .left = detail::as_expression(left), .right = detail::as_expression(right) };
+    }
+
+    template<typename TyLeft, typename TyRight>
+    requires( detail::expression_operands<TyLeft,TyRight> )
+    [[nodiscard]] constexpr auto operator/( const TyLeft& left, const TyRight& right ) noexcept
+    {
+        return detail::binary_expression_for<std::divides<>,TyLeft,TyRight>{ .left = detail::as_expression(left), .right = detail::as_expression(right) };
+    }
+
+    template<detail::qty_expression TyOperand>
+    [[nodiscard]] constexpr auto operator-( const TyOperand& operand ) noexcept
+    {
+        return detail::negate_expression<TyOperand>{ .operand = operand };
+    }
+}
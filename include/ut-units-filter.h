@@ -0,0 +1,285 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include "ut-units-soa.h"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+
+namespace ut
+{
+    // frequency and angular_rate have the same SI dimensions so they can not be
+    // told apart by type. Filter design functions take cutoffs in cycles per
+    // second, angular cutoffs (rad/s) are converted explicitly with this.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr frequency<T> cycles_per_second( angular_rate<T> rate ) noexcept
+    {
+        return frequency<T>{ rate.value / ( T(2) * std::numbers::pi_v<T> ) };
+    }
+
+    template<std::floating_point T>
+    struct low_pass_coefficients
+    {
+        T alpha; // weight of the new sample
+    };
+
+    template<std::floating_point T>
+    struct complementary_coefficients
+    {
+        T alpha;            // weight of the integrated rate path
+        time<T> sample_period;
+    };
+
+    // Normalised so a0 is 1
+    template<std::floating_point T>
+    struct biquad_coefficients
+    {
+        T b0, b1, b2;
+        T a1, a2;
+    };
+
+    // First order low pass with the pole matched to cutoff, y += alpha * (x - y)
+    template<std::floating_point T>
+    [[nodiscard]] low_pass_coefficients<T> design_low_pass( frequency<T> cutoff, time<T> sample_period ) noexcept
+    {
+        return { T(1) - std::exp( -T(2) * std::numbers::pi_v<T> * ( cutoff * sample_period ).value ) };
+    }
+
+    // Crossover at cutoff, below it the measurement is trusted and above it the integrated rate
+    template<std::floating_point T>
+    [[nodiscard]] complementary_coefficients<T> design_complementary( frequency<T> cutoff, time<T> sample_period ) noexcept
+    {
+        return { std::exp( -T(2) * std::numbers::pi_v<T> * ( cutoff * sample_period ).value ), sample_period };
+    }
+} // end namespace ut
+
+namespace ut::detail
+{
+    enum class biquad_type { low_pass, high_pass, band_pass, notch };
+
+    // Audio EQ cookbook, R. Bristow-Johnson
+    template<biquad_type Type, std::floating_point T>
+    [[nodiscard]] biquad_coefficients<T> design_biquad( frequency<T> centre, time<T> sample_period, T q ) noexcept
+    {
+        assert( ( centre * sample_period ).value < T(0.5) ); // below the Nyquist frequency
+        const T omega = T(2) * std::numbers::pi_v<T> * ( centre * sample_period ).value;
+        const T cos_omega = std::cos( omega );
+        const T alpha = std::sin( omega ) / ( T(2) * q );
+        const T a0 = T(1) + alpha;
+
+        T b0, b1, b2;
+        if constexpr ( Type == biquad_type::low_pass )
+        {
+            b0 = ( T(1) - cos_omega ) / T(2);
+            b1 = T(1) - cos_omega;
+            b2 = b0;
+        }
+        else if constexpr ( Type == biquad_type::high_pass )
+        {
+            b0 = ( T(1) + cos_omega ) / T(2);
+            b1 = -( T(1) + cos_omega );
+            b2 = b0;
+        }
+        else if constexpr ( Type == biquad_type::band_pass )
+        {
+            b0 = alpha;
+            b1 = T(0);
+            b2 = -alpha;
+        }
+        else
+        {
+            b0 = T(1);
+            b1 = T(-2) * cos_omega;
+            b2 = T(1);
+        }
+        return { b0 / a0, b1 / a0, b2 / a0, T(-2) * cos_omega / a0, ( T(1) - alpha ) / a0 };
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    template<std::floating_point T>
+    [[nodiscard]] biquad_coefficients<T> design_biquad_low_pass( frequency<T> cutoff, time<T> sample_period, T q = std::numbers::sqrt2_v<T> / T(2) ) noexcept
+    {
+        return detail::design_biquad<detail::biquad_type::low_pass>( cutoff, sample_period, q );
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] biquad_coefficients<T> design_biquad_high_pass( frequency<T> cutoff, time<T> sample_period, T q = std::numbers::sqrt2_v<T> / T(2) ) noexcept
+    {
+        return detail::design_biquad<detail::biquad_type::high_pass>( cutoff, sample_period, q );
+    }
+
+    // Unity gain at centre
+    template<std::floating_point T>
+    [[nodiscard]] biquad_coefficients<T> design_biquad_band_pass( frequency<T> centre, time<T> sample_period, T q ) noexcept
+    {
+        return detail::design_biquad<detail::biquad_type::band_pass>( centre, sample_period, q );
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] biquad_coefficients<T> design_biquad_notch( frequency<T> centre, time<T> sample_period, T q ) noexcept
+    {
+        return detail::design_biquad<detail::biquad_type::notch>( centre, sample_period, q );
+    }
+
+    template<detail::qty_type Qty>
+    struct low_pass_filter
+    {
+        using T = typename Qty::type;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE Qty operator()( Qty input ) noexcept
+        {
+            state += coefficients.alpha * ( input - state );
+            return state;
+        }
+
+        void reset( Qty value = Qty{ T(0) } ) noexcept { state = value; }
+
+        low_pass_coefficients<T> coefficients;
+        Qty state{ T(0) };
+    };
+
+    // Fuses a rate which is accurate at high frequency (e.g. a gyro) with a
+    // measurement which is accurate at low frequency (e.g. an accelerometer angle).
+    template<detail::qty_type Qty>
+    struct complementary_filter
+    {
+        using T = typename Qty::type;
+        using rate_type = detail::qty_divide<T, typename Qty::dimensions, typename time<T>::dimensions>;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE Qty operator()( rate_type rate, Qty measurement ) noexcept
+        {
+            state = coefficients.alpha * ( state + rate * coefficients.sample_period ) + ( T(1) - coefficients.alpha ) * measurement;
+            return state;
+        }
+
+        void reset( Qty value = Qty{ T(0) } ) noexcept { state = value; }
+
+        complementary_coefficients<T> coefficients;
+        Qty state{ T(0) };
+    };
+
+    // Transposed direct form II
+    template<detail::qty_type Qty>
+    struct biquad_filter
+    {
+        using T = typename Qty::type;
+
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE Qty operator()( Qty input ) noexcept
+        {
+            const Qty output = coefficients.b0 * input + z1;
+            z1 = coefficients.b1 * input - coefficients.a1 * output + z2;
+            z2 = coefficients.b2 * input - coefficients.a2 * output;
+            return output;
+        }
+
+        // Sets the state as if value had been the input forever
+        void reset( Qty value = Qty{ T(0) } ) noexcept
+        {
+            const T gain = ( coefficients.b0 + coefficients.b1 + coefficients.b2 ) / ( T(1) + coefficients.a1 + coefficients.a2 );
+            const Qty output = gain * value;
+            z2 = coefficients.b2 * value - coefficients.a2 * output;
+            z1 = coefficients.b1 * value - coefficients.a1 * output + z2;
+        }
+
+        biquad_coefficients<T> coefficients;
+        Qty z1{ T(0) };
+        Qty z2{ T(0) };
+    };
+
+    // Many low pass channels of one quantity type, each with its own coefficients,
+    // stored as columns so process() vectorises across channels.
+    template<detail::qty_type Qty>
+    struct low_pass_bank
+    {
+        using T = typename Qty::type;
+
+        std::size_t add_channel( low_pass_coefficients<T> coefficients, Qty initial = Qty{ T(0) } )
+        {
+            alpha.push_back( coefficients.alpha );
+            state.push_back( initial );
+            return state.size() - 1;
+        }
+
+        // One sample per channel
+        void process( std::span<const Qty> input, std::span<Qty> output ) noexcept
+        {
+            assert( input.size() == size() && output.size() == size() );
+            const std::size_t count = size();
+            for ( std::size_t i = 0; i < count; i++ )
+            {
+                state[i].value += alpha[i] * ( input[i].value - state[i].value );
+                output[i] = state[i];
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return state.size(); }
+
+        detail::soa_column<T> alpha;
+        detail::soa_column<Qty> state;
+    };
+
+    // Many biquad channels of one quantity type, see low_pass_bank.
+    template<detail::qty_type Qty>
+    struct biquad_bank
+    {
+        using T = typename Qty::type;
+
+        std::size_t add_channel( biquad_coefficients<T> coefficients )
+        {
+            b0.push_back( coefficients.b0 );
+            b1.push_back( coefficients.b1 );
+            b2.push_back( coefficients.b2 );
+            a1.push_back( coefficients.a1 );
+            a2.push_back( coefficients.a2 );
+            z1.push_back( Qty{ T(0) } );
+            z2.push_back( Qty{ T(0) } );
+            return z1.size() - 1;
+        }
+
+        // One sample per channel
+        void process( std::span<const Qty> input, std::span<Qty> output ) noexcept
+        {
+            assert( input.size() == size() && output.size() == size() );
+            const std::size_t count = size();
+            for ( std::size_t i = 0; i < count; i++ )
+            {
+                const T x = input[i].value;
+                const T y = b0[i] * x + z1[i].value;
+                z1[i].value = b1[i] * x - a1[i] * y + z2[i].value;
+                z2[i].value = b2[i] * x - a2[i] * y;
+                output[i].value = y;
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return z1.size(); }
+
+        detail::soa_column<T> b0, b1, b2, a1, a2;
+        detail::soa_column<Qty> z1, z2;
+    };
+} // end namespace ut
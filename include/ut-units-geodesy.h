@@ -0,0 +1,204 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <span>
+
+namespace ut::geo
+{
+    // IUGG mean earth radius, used by the spherical functions
+    static constexpr qty mean_radius                = 6371008.8 * metre;
+
+    // WGS 84 ellipsoid, used by vincenty_distance
+    static constexpr qty wgs84_semi_major_axis      = 6378137.0 * metre;
+    static constexpr double wgs84_flattening        = 1.0 / 298.257223563;
+    static constexpr qty wgs84_semi_minor_axis      = ( 1.0 - wgs84_flattening ) * wgs84_semi_major_axis;
+
+    template<std::floating_point T>
+    struct position
+    {
+        angle<T> latitude;
+        angle<T> longitude;
+    };
+} // end namespace ut::geo
+
+namespace ut::detail
+{
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T haversine( T latitude1, T longitude1, T latitude2, T longitude2, T radius ) noexcept
+    {
+        const T sin_latitude = std::sin( T(0.5) * ( latitude2 - latitude1 ) );
+        const T sin_longitude = std::sin( T(0.5) * ( longitude2 - longitude1 ) );
+        const T h = sin_latitude * sin_latitude + std::cos( latitude1 ) * std::cos( latitude2 ) * sin_longitude * sin_longitude;
+        return T(2) * radius * std::asin( std::min( T(1), std::sqrt( h ) ) );
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T initial_bearing( T latitude1, T longitude1, T latitude2, T longitude2 ) noexcept
+    {
+        const T delta_longitude = longitude2 - longitude1;
+        const T cos_latitude2 = std::cos( latitude2 );
+        const T bearing = std::atan2( std::sin( delta_longitude ) * cos_latitude2,
+            std::cos( latitude1 ) * std::sin( latitude2 ) - std::sin( latitude1 ) * cos_latitude2 * std::cos( delta_longitude ) );
+        return bearing < T(0) ? bearing + T(2) * std::numbers::pi_v<T> : bearing;
+    }
+
+    template<std::floating_point T>
+    UT_UNITS_CRITICAL_INLINE void destination( T latitude, T longitude, T bearing, T angular_distance, T& latitude_out, T& longitude_out ) noexcept
+    {
+        constexpr T two_pi = T(2) * std::numbers::pi_v<T>;
+        const T sin_latitude = std::sin( latitude );
+        const T cos_latitude = std::cos( latitude );
+        const T sin_distance = std::sin( angular_distance );
+        const T cos_distance = std::cos( angular_distance );
+
+        const T sin_latitude_out = sin_latitude * cos_distance + cos_latitude * sin_distance * std::cos( bearing );
+        latitude_out = std::asin( std::clamp( sin_latitude_out, T(-1), T(1) ) );
+        const T longitude_unwrapped = longitude + std::atan2( std::sin( bearing ) * sin_distance * cos_latitude, cos_distance - sin_latitude * sin_latitude_out );
+        longitude_out = longitude_unwrapped - two_pi * std::nearbyint( longitude_unwrapped / two_pi );
+    }
+} // end namespace ut::detail
+
+namespace ut::geo
+{
+    // Great circle distance on a sphere, within about 0.5% of the ellipsoidal distance
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE length<T> haversine_distance( position<T> from, position<T> to, length<T> radius = length<T>{ T(mean_radius.value) } ) noexcept
+    {
+        return length<T>{ detail::haversine( from.latitude.value, from.longitude.value, to.latitude.value, to.longitude.value, radius.value ) };
+    }
+
+    // Initial great circle bearing from north in [0, 2 pi)
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE angle<T> initial_bearing( position<T> from, position<T> to ) noexcept
+    {
+        return angle<T>{ detail::initial_bearing( from.latitude.value, from.longitude.value, to.latitude.value, to.longitude.value ) };
+    }
+
+    // Point reached travelling distance along a great circle from start, longitude in [-pi, pi]
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE position<T> destination( position<T> start, angle<T> bearing, length<T> distance, length<T> radius = length<T>{ T(mean_radius.value) } ) noexcept
+    {
+        position<T> result;
+        detail::destination( start.latitude.value, start.longitude.value, bearing.value, distance.value / radius.value, result.latitude.value, result.longitude.value );
+        return result;
+    }
+
+    // Distance on the WGS 84 ellipsoid by Vincenty's inverse formula, accurate to
+    // well under a millimetre. For nearly antipodal points where the iteration does
+    // not converge the last iterate is used.
+    template<std::floating_point T>
+    [[nodiscard]] length<T> vincenty_distance( position<T> from, position<T> to ) noexcept
+    {
+        const T a = T(wgs84_semi_major_axis.value);
+        const T b = T(wgs84_semi_minor_axis.value);
+        const T f = T(wgs84_flattening);
+        const T tolerance = std::max( T(1e-12), T(4) * std::numeric_limits<T>::epsilon() );
+
+        const T L = to.longitude.value - from.longitude.value;
+        const T U1 = std::atan( ( T(1) - f ) * std::tan( from.latitude.value ) );
+        const T U2 = std::atan( ( T(1) - f ) * std::tan( to.latitude.value ) );
+        const T sin_U1 = std::sin( U1 ), cos_U1 = std::cos( U1 );
+        const T sin_U2 = std::sin( U2 ), cos_U2 = std::cos( U2 );
+
+        T lambda = L;
+        T sin_sigma = 0, cos_sigma = 0, sigma = 0, cos2_alpha = 0, cos_2sigma_m = 0;
+        for ( int iteration = 0; iteration < 200; iteration++ )
+        {
+            const T sin_lambda = std::sin( lambda );
+            const T cos_lambda = std::cos( lambda );
+            const T x = cos_U2 * sin_lambda;
+            const T y = cos_U1 * sin_U2 - sin_U1 * cos_U2 * cos_lambda;
+            sin_sigma = std::sqrt( x * x + y * y );
+            if ( sin_sigma == T(0) )
+                return length<T>{ T(0) }; // coincident points
+
+            cos_sigma = sin_U1 * sin_U2 + cos_U1 * cos_U2 * cos_lambda;
+            sigma = std::atan2( sin_sigma, cos_sigma );
+            const T sin_alpha = cos_U1 * cos_U2 * sin_lambda / sin_sigma;
+            cos2_alpha = T(1) - sin_alpha * sin_alpha;
+            cos_2sigma_m = cos2_alpha != T(0) ? cos_sigma - T(2) * sin_U1 * sin_U2 / cos2_alpha : T(0); // equatorial line
+            const T C = f / T(16) * cos2_alpha * ( T(4) + f * ( T(4) - T(3) * cos2_alpha ) );
+
+            const T previous = lambda;
+            lambda = L + ( T(1) - C ) * f * sin_alpha
+                * ( sigma + C * sin_sigma * ( cos_2sigma_m + C * cos_sigma * ( T(-1) + T(2) * cos_2sigma_m * cos_2sigma_m ) ) );
+            if ( std::abs( lambda - previous ) < tolerance )
+                break;
+        }
+
+        const T u2 = cos2_alpha * ( a * a - b * b ) / ( b * b );
+        const T A = T(1) + u2 / T(16384) * ( T(4096) + u2 * ( T(-768) + u2 * ( T(320) - T(175) * u2 ) ) );
+        const T B = u2 / T(1024) * ( T(256) + u2 * ( T(-128) + u2 * ( T(74) - T(47) * u2 ) ) );
+        const T delta_sigma = B * sin_sigma * ( cos_2sigma_m + B / T(4) * ( cos_sigma * ( T(-1) + T(2) * cos_2sigma_m * cos_2sigma_m )
+            - B / T(6) * cos_2sigma_m * ( T(-3) + T(4) * sin_sigma * sin_sigma ) * ( T(-3) + T(4) * cos_2sigma_m * cos_2sigma_m ) ) );
+
+        return length<T>{ b * A * ( sigma - delta_sigma ) };
+    }
+
+    // Batch versions, out[i] is computed from from[i] and to[i]. The loops are
+    // branch free so they vectorise where the compiler has vector math functions
+    // (e.g. GCC with glibc and -O3 -ffast-math).
+    template<std::floating_point T>
+    void haversine_distance( std::span<const position<T>> from, std::span<const position<T>> to, std::span<length<T>> out,
+        length<T> radius = length<T>{ T(mean_radius.value) } ) noexcept
+    {
+        assert( from.size() == to.size() && out.size() == from.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = detail::haversine( from[i].latitude.value, from[i].longitude.value, to[i].latitude.value, to[i].longitude.value, radius.value );
+    }
+
+    template<std::floating_point T>
+    void initial_bearing( std::span<const position<T>> from, std::span<const position<T>> to, std::span<angle<T>> out ) noexcept
+    {
+        assert( from.size() == to.size() && out.size() == from.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i].value = detail::initial_bearing( from[i].latitude.value, from[i].longitude.value, to[i].latitude.value, to[i].longitude.value );
+    }
+
+    template<std::floating_point T>
+    void destination( std::span<const position<T>> start, std::span<const angle<T>> bearing, std::span<const length<T>> distance,
+        std::span<position<T>> out, length<T> radius = length<T>{ T(mean_radius.value) } ) noexcept
+    {
+        assert( start.size() == bearing.size() && start.size() == distance.size() && out.size() == start.size() );
+        const T inverse_radius = T(1) / radius.value;
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            detail::destination( start[i].latitude.value, start[i].longitude.value, bearing[i].value, distance[i].value * inverse_radius,
+                out[i].latitude.value, out[i].longitude.value );
+    }
+
+    template<std::floating_point T>
+    void vincenty_distance( std::span<const position<T>> from, std::span<const position<T>> to, std::span<length<T>> out ) noexcept
+    {
+        assert( from.size() == to.size() && out.size() == from.size() );
+        for ( std::size_t i = 0; i < out.size(); i++ )
+            out[i] = vincenty_distance( from[i], to[i] );
+    }
+} // end namespace ut::geo
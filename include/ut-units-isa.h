@@ -0,0 +1,324 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+// International Standard Atmosphere, ICAO Doc 7488 / US Standard Atmosphere 1976
+namespace ut::isa
+{
+    static constexpr qty standard_gravity           = 9.80665 * metre_per_second2;
+    static constexpr qty specific_gas_constant      = 287.05287 * joule / ( kilogram * kelvin );
+    static constexpr qty earth_radius               = 6356766.0 * metre;
+
+    static constexpr qty sea_level_temperature      = 288.15 * kelvin;
+    static constexpr qty sea_level_pressure         = 101325.0 * pascal;
+    static constexpr qty sea_level_density          = sea_level_pressure / ( specific_gas_constant * sea_level_temperature );
+
+    static constexpr qty tropopause_altitude        = 11000.0 * metre;
+
+    template<std::floating_point T>
+    struct conditions
+    {
+        ut::temperature<T> temperature;
+        ut::pressure<T> pressure;
+        ut::density<T> density;
+    };
+} // end namespace ut::isa
+
+namespace ut::detail
+{
+    struct isa_layer
+    {
+        double base_altitude;       // geopotential, m
+        double lapse_rate;          // K/m
+        double base_temperature;    // K
+        double base_pressure;       // Pa
+    };
+
+    // Base pressures are derived from the layer definitions with the constants above,
+    // they agree with the published tables to their printed precision.
+    inline constexpr std::array<isa_layer, 7> isa_layers{ {
+        {     0.0, -0.0065, 288.15, 101325.0 },
+        { 11000.0,  0.0,    216.65, 22632.040095007793 },
+        { 20000.0,  0.001,  216.65, 5474.877424281044 },
+        { 32000.0,  0.0028, 228.65, 868.015776620215 },
+        { 47000.0,  0.0,    270.65, 110.90577336731009 },
+        { 51000.0, -0.0028, 270.65, 66.93852812117976 },
+        { 71000.0, -0.002,  214.65, 3.9563921603966064 },
+    } };
+
+    // g0 / R, K/m
+    inline constexpr double isa_gravity_over_gas_constant = isa::standard_gravity.value / isa::specific_gas_constant.value;
+
+    // Altitude range of the closed form lower atmosphere (troposphere and tropopause layer)
+    inline constexpr double isa_lower_floor = -5000.0;
+    inline constexpr double isa_lower_ceiling = 20000.0;
+
+    inline constexpr std::size_t isa_block_size = 256;
+
+    // Index of the layer containing altitude, branch free. Below the first
+    // layer the troposphere is extended, above the last the mesosphere is.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr std::size_t isa_layer_index( T altitude ) noexcept
+    {
+        std::size_t index = 0;
+        for ( std::size_t i = 1; i < isa_layers.size(); i++ )
+            index += altitude >= T(isa_layers[i].base_altitude);
+        return index;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr std::size_t isa_layer_index_from_pressure( T pressure ) noexcept
+    {
+        std::size_t index = 0;
+        for ( std::size_t i = 1; i < isa_layers.size(); i++ )
+            index += pressure <= T(isa_layers[i].base_pressure);
+        return index;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE isa::conditions<T> isa_layered( T altitude ) noexcept
+    {
+        const isa_layer& layer = isa_layers[isa_layer_index(altitude)];
+        const T base_temperature = T(layer.base_temperature);
+        const T height = altitude - T(layer.base_altitude);
+        const T temperature = base_temperature + T(layer.lapse_rate) * height;
+
+        T pressure;
+        if ( layer.lapse_rate == 0.0 )
+            pressure = T(layer.base_pressure) * std::exp( T(-isa_gravity_over_gas_constant / layer.base_temperature) * height );
+        else
+            pressure = T(layer.base_pressure) * std::pow( temperature / base_temperature, T(-isa_gravity_over_gas_constant / layer.lapse_rate) );
+
+        isa::conditions<T> result;
+        result.temperature.value = temperature;
+        result.pressure.value = pressure;
+        result.density.value = pressure / ( T(isa::specific_gas_constant.value) * temperature );
+        return result;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T isa_layered_pressure_altitude( T pressure ) noexcept
+    {
+        const isa_layer& layer = isa_layers[isa_layer_index_from_pressure(pressure)];
+        const T ratio = pressure / T(layer.base_pressure);
+        if ( layer.lapse_rate == 0.0 )
+            return T(layer.base_altitude) - T(layer.base_temperature / isa_gravity_over_gas_constant) * std::log( ratio );
+        else
+            return T(layer.base_altitude) + T(layer.base_temperature / layer.lapse_rate)
+                * ( std::pow( ratio, T(-layer.lapse_rate / isa_gravity_over_gas_constant) ) - T(1) );
+    }
+
+    // Closed form of the first two layers, both sides are evaluated and selected
+    // so there are no branches or table lookups and loops over it vectorise.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE isa::conditions<T> isa_lower( T altitude ) noexcept
+    {
+        constexpr isa_layer troposphere = isa_layers[0];
+        constexpr isa_layer tropopause = isa_layers[1];
+
+        const T troposphere_temperature = T(troposphere.base_temperature) + T(troposphere.lapse_rate) * altitude;
+        const T troposphere_pressure = T(troposphere.base_pressure)
+            * std::pow( troposphere_temperature * T(1.0 / troposphere.base_temperature), T(-isa_gravity_over_gas_constant / troposphere.lapse_rate) );
+        const T tropopause_pressure = T(tropopause.base_pressure)
+            * std::exp( T(-isa_gravity_over_gas_constant / tropopause.base_temperature) * ( altitude - T(tropopause.base_altitude) ) );
+
+        const bool below = altitude < T(tropopause.base_altitude);
+        const T temperature = below ? troposphere_temperature : T(tropopause.base_temperature);
+        const T pressure = below ? troposphere_pressure : tropopause_pressure;
+
+        isa::conditions<T> result;
+        result.temperature.value = temperature;
+        result.pressure.value = pressure;
+        result.density.value = pressure / ( T(isa::specific_gas_constant.value) * temperature );
+        return result;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T isa_lower_pressure_altitude( T pressure ) noexcept
+    {
+        constexpr isa_layer troposphere = isa_layers[0];
+        constexpr isa_layer tropopause = isa_layers[1];
+
+        const T troposphere_altitude = T(troposphere.base_temperature / troposphere.lapse_rate)
+            * ( std::pow( pressure * T(1.0 / troposphere.base_pressure), T(-troposphere.lapse_rate / isa_gravity_over_gas_constant) ) - T(1) );
+        const T tropopause_altitude = T(tropopause.base_altitude)
+            - T(tropopause.base_temperature / isa_gravity_over_gas_constant) * std::log( pressure * T(1.0 / tropopause.base_pressure) );
+
+        return pressure > T(tropopause.base_pressure) ? troposphere_altitude : tropopause_altitude;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE bool isa_in_lower( std::span<const length<T>> altitudes ) noexcept
+    {
+        bool inside = true;
+        for ( const length<T>& value : altitudes )
+            inside &= ( value.value >= T(isa_lower_floor) ) & ( value.value <= T(isa_lower_ceiling) );
+        return inside;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE bool isa_in_lower( std::span<const pressure<T>> pressures ) noexcept
+    {
+        const T highest = isa_lower( T(isa_lower_floor) ).pressure.value;
+        const T lowest = isa_lower( T(isa_lower_ceiling) ).pressure.value;
+        bool inside = true;
+        for ( const pressure<T>& value : pressures )
+            inside &= ( value.value <= highest ) & ( value.value >= lowest );
+        return inside;
+    }
+} // end namespace ut::detail
+
+namespace ut::isa
+{
+    // Geopotential altitude from geometric altitude
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr length<T> geopotential_altitude( length<T> geometric ) noexcept
+    {
+        const T radius = T(earth_radius.value);
+        return length<T>{ radius * geometric.value / ( radius + geometric.value ) };
+    }
+
+    // Geometric altitude from geopotential altitude
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr length<T> geometric_altitude( length<T> geopotential ) noexcept
+    {
+        const T radius = T(earth_radius.value);
+        return length<T>{ radius * geopotential.value / ( radius - geopotential.value ) };
+    }
+
+    // Conditions at a geopotential altitude. The published tables cover -5 km to 80 km,
+    // outside of that the lowest and highest layers are extended.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE conditions<T> at( length<T> altitude ) noexcept
+    {
+        return detail::isa_layered( altitude.value );
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE ut::temperature<T> temperature_at( length<T> altitude ) noexcept
+    {
+        const detail::isa_layer& layer = detail::isa_layers[detail::isa_layer_index(altitude.value)];
+        return ut::temperature<T>{ T(layer.base_temperature) + T(layer.lapse_rate) * ( altitude.value - T(layer.base_altitude) ) };
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE ut::pressure<T> pressure_at( length<T> altitude ) noexcept
+    {
+        return at( altitude ).pressure;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE ut::density<T> density_at( length<T> altitude ) noexcept
+    {
+        return at( altitude ).density;
+    }
+
+    // Geopotential altitude at which the standard atmosphere has this pressure
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE length<T> pressure_altitude( ut::pressure<T> pressure ) noexcept
+    {
+        return length<T>{ detail::isa_layered_pressure_altitude( pressure.value ) };
+    }
+
+    // Table free closed form of the troposphere and tropopause layer, valid
+    // from -5 km to 20 km which covers the flight envelope of most aircraft.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE conditions<T> lower_at( length<T> altitude ) noexcept
+    {
+        assert( altitude.value >= T(detail::isa_lower_floor) && altitude.value <= T(detail::isa_lower_ceiling) );
+        return detail::isa_lower( altitude.value );
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE length<T> lower_pressure_altitude( ut::pressure<T> pressure ) noexcept
+    {
+        return length<T>{ detail::isa_lower_pressure_altitude( pressure.value ) };
+    }
+
+    // Batch evaluation of at(). Blocks which lie entirely in the lower atmosphere use the
+    // closed form, which vectorises where the compiler has vector math functions
+    // (e.g. GCC with glibc and -O3 -fno-math-errno), other blocks use the layered model.
+    template<std::floating_point T>
+    void at( std::span<const length<T>> altitudes, std::span<ut::temperature<T>> temperatures,
+        std::span<ut::pressure<T>> pressures, std::span<ut::density<T>> densities ) noexcept
+    {
+        assert( temperatures.size() == altitudes.size() && pressures.size() == altitudes.size() && densities.size() == altitudes.size() );
+        for ( std::size_t start = 0; start < altitudes.size(); start += detail::isa_block_size )
+        {
+            const std::size_t count = std::min( detail::isa_block_size, altitudes.size() - start );
+            const length<T>* altitude = altitudes.data() + start;
+            ut::temperature<T>* temperature = temperatures.data() + start;
+            ut::pressure<T>* pressure = pressures.data() + start;
+            ut::density<T>* density = densities.data() + start;
+
+            if ( detail::isa_in_lower( std::span( altitude, count ) ) )
+            {
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    const conditions<T> result = detail::isa_lower( altitude[i].value );
+                    temperature[i] = result.temperature;
+                    pressure[i] = result.pressure;
+                    density[i] = result.density;
+                }
+            }
+            else
+            {
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    const conditions<T> result = detail::isa_layered( altitude[i].value );
+                    temperature[i] = result.temperature;
+                    pressure[i] = result.pressure;
+                    density[i] = result.density;
+                }
+            }
+        }
+    }
+
+    // Batch evaluation of pressure_altitude(), see at() for the fast path.
+    template<std::floating_point T>
+    void pressure_altitude( std::span<const ut::pressure<T>> pressures, std::span<length<T>> altitudes ) noexcept
+    {
+        assert( altitudes.size() == pressures.size() );
+        for ( std::size_t start = 0; start < pressures.size(); start += detail::isa_block_size )
+        {
+            const std::size_t count = std::min( detail::isa_block_size, pressures.size() - start );
+            const ut::pressure<T>* pressure = pressures.data() + start;
+            length<T>* altitude = altitudes.data() + start;
+
+            if ( detail::isa_in_lower( std::span( pressure, count ) ) )
+                for ( std::size_t i = 0; i < count; i++ )
+                    altitude[i].value = detail::isa_lower_pressure_altitude( pressure[i].value );
+            else
+                for ( std::size_t i = 0; i < count; i++ )
+                    altitude[i].value = detail::isa_layered_pressure_altitude( pressure[i].value );
+        }
+    }
+} // end namespace ut::isa
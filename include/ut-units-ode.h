@@ -0,0 +1,423 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ut::detail
+{
+    // States are a qty, or std::tuple / std::array of states. The derivative
+    // of every qty leaf is that leaf divided by time.
+    template<typename State>
+    struct qty_derivative_s;
+
+    template<std::floating_point T, qty_dimensions_type dimensions>
+    struct qty_derivative_s<qty<T,dimensions>>
+    {
+        using type = qty_divide<T, dimensions, qty_dimensions<1>>;
+        using scalar = T;
+    };
+
+    template<typename First, typename... Rest>
+    struct qty_derivative_s<std::tuple<First, Rest...>>
+    {
+        using type = std::tuple<typename qty_derivative_s<First>::type, typename qty_derivative_s<Rest>::type...>;
+        using scalar = qty_derivative_s<First>::scalar;
+    };
+
+    template<typename State, std::size_t N>
+    struct qty_derivative_s<std::array<State,N>>
+    {
+        using type = std::array<typename qty_derivative_s<State>::type, N>;
+        using scalar = qty_derivative_s<State>::scalar;
+    };
+
+    template<typename State>
+    using qty_derivative = qty_derivative_s<State>::type;
+
+    template<typename State>
+    using state_scalar = qty_derivative_s<State>::scalar;
+
+    template<typename T>
+    struct is_std_array : std::false_type {};
+
+    template<typename T, std::size_t N>
+    struct is_std_array<std::array<T,N>> : std::true_type {};
+
+    template<typename F, typename State, typename... Others>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr State ode_map( F&& f, const State& y, const Others&... others );
+
+    template<typename F, typename State, typename... Others>
+    UT_UNITS_CRITICAL_INLINE constexpr void ode_for_each( F&& f, const State& y, const Others&... others );
+
+    template<std::size_t I, typename F, typename State, typename... Others>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr auto ode_map_element( F& f, const State& y, const Others&... others )
+    {
+        return ode_map( f, std::get<I>( y ), std::get<I>( others )... );
+    }
+
+    template<std::size_t I, typename F, typename State, typename... Others>
+    UT_UNITS_CRITICAL_INLINE constexpr void ode_for_each_element( F& f, const State& y, const Others&... others )
+    {
+        ode_for_each( f, std::get<I>( y ), std::get<I>( others )... );
+    }
+
+    // Applies f to each qty leaf of y and the matching leaves of others, rebuilding a State.
+    template<typename F, typename State, typename... Others>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr State ode_map( F&& f, const State& y, const Others&... others )
+    {
+        if constexpr ( qty_type<State> )
+        {
+            return f( y, others... );
+        }
+        else if constexpr ( is_std_array<State>::value )
+        {
+            State result;
+            for ( std::size_t i = 0; i < result.size(); i++ )
+                result[i] = ode_map( f, y[i], others[i]... );
+            return result;
+        }
+        else
+        {
+            return [&]<std::size_t... I>( std::index_sequence<I...> ) {
+                return State{ ode_map_element<I>( f, y, others... )... };
+            }( std::make_index_sequence<std::tuple_size_v<State>>{} );
+        }
+    }
+
+    // Calls f on each qty leaf of y and the matching leaves of others.
+    template<typename F, typename State, typename... Others>
+    UT_UNITS_CRITICAL_INLINE constexpr void ode_for_each( F&& f, const State& y, const Others&... others )
+    {
+        if constexpr ( qty_type<State> )
+        {
+            f( y, others... );
+        }
+        else if constexpr ( is_std_array<State>::value )
+        {
+            for ( std::size_t i = 0; i < y.size(); i++ )
+                ode_for_each( f, y[i], others[i]... );
+        }
+        else
+        {
+            [&]<std::size_t... I>( std::index_sequence<I...> ) {
+                ( ode_for_each_element<I>( f, y, others... ), ... );
+            }( std::make_index_sequence<std::tuple_size_v<State>>{} );
+        }
+    }
+
+    // Butcher tableau of Dormand-Prince, e = b (5th order) - b* (4th order)
+    template<std::floating_point T>
+    struct dormand_prince_tableau
+    {
+        static constexpr T c2 = T(1) / T(5), c3 = T(3) / T(10), c4 = T(4) / T(5), c5 = T(8) / T(9);
+        static constexpr T a21 = T(1) / T(5);
+        static constexpr T a31 = T(3) / T(40), a32 = T(9) / T(40);
+        static constexpr T a41 = T(44) / T(45), a42 = T(-56) / T(15), a43 = T(32) / T(9);
+        static constexpr T a51 = T(19372) / T(6561), a52 = T(-25360) / T(2187), a53 = T(64448) / T(6561), a54 = T(-212) / T(729);
+        static constexpr T a61 = T(9017) / T(3168), a62 = T(-355) / T(33), a63 = T(46732) / T(5247), a64 = T(49) / T(176), a65 = T(-5103) / T(18656);
+        static constexpr T b1 = T(35) / T(384), b3 = T(500) / T(1113), b4 = T(125) / T(192), b5 = T(-2187) / T(6784), b6 = T(11) / T(84);
+        static constexpr T e1 = T(71) / T(57600), e3 = T(-71) / T(16695), e4 = T(71) / T(1920), e5 = T(-17253) / T(339200), e6 = T(22) / T(525), e7 = T(-1) / T(40);
+    };
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Derivative type of a state: each qty leaf divided by time.
+    template<typename State>
+    using derivative_of = detail::qty_derivative<State>;
+
+    // One classic fourth order Runge-Kutta step of dy/dt = f(t, y).
+    // f is called as f(time<T>, const State&) and must return derivative_of<State>.
+    template<typename F, typename State, std::floating_point T>
+    [[nodiscard]] constexpr State rk4_step( F&& f, time<T> t, const State& y, time<T> dt )
+    {
+        using derivative = derivative_of<State>;
+        const time<T> half = dt * T(0.5);
+        const time<T> sixth = dt / T(6);
+
+        const derivative k1 = f( t, y );
+        const derivative k2 = f( t + half, detail::ode_map( [&]( auto y0, auto k ) { return y0 + k * half; }, y, k1 ) );
+        const derivative k3 = f( t + half, detail::ode_map( [&]( auto y0, auto k ) { return y0 + k * half; }, y, k2 ) );
+        const derivative k4 = f( t + dt, detail::ode_map( [&]( auto y0, auto k ) { return y0 + k * dt; }, y, k3 ) );
+
+        return detail::ode_map( [&]( auto y0, auto a, auto b, auto c, auto d ) {
+            return y0 + ( a + T(2) * b + T(2) * c + d ) * sixth;
+        }, y, k1, k2, k3, k4 );
+    }
+
+    enum class ode_status
+    {
+        ok,
+        step_underflow,         // a step of min_dt was rejected or the step no longer advances time
+        too_many_rejections     // max_rejections consecutive steps were rejected
+    };
+
+    // Adaptive fifth order Dormand-Prince (RK45) integrator.
+    // The error estimate is dimension aware: each leaf of the error is
+    // divided by absolute_tolerance + relative_tolerance * |y| of the same
+    // leaf (so absolute_tolerance is itself a State) and the RMS of those
+    // dimensionless ratios must be <= 1 to accept a step.
+    // Dormand, J. R.; Prince, P. J. (1980) "A family of embedded Runge-Kutta formulae"
+    template<typename State>
+    struct dormand_prince
+    {
+        using T = detail::state_scalar<State>;
+        using derivative = derivative_of<State>;
+
+        State absolute_tolerance;
+        T relative_tolerance = T(1.0e-6);
+        time<T> dt = { T(1.0e-3) };                                     // next step size, adapted after every attempt
+        time<T> min_dt = { T(0) };
+        time<T> max_dt = { std::numeric_limits<T>::infinity() };
+        std::size_t max_rejections = 100;                               // consecutive rejections before integrate fails
+        std::size_t accepted_steps = 0;
+        std::size_t rejected_steps = 0;
+
+        // Attempts one step of size dt. On success t and y are advanced.
+        // Returns whether the step was accepted, dt is updated either way.
+        template<typename F>
+        bool step( F&& f, time<T>& t, State& y )
+        {
+            derivative k1 = f( t, y );
+            return attempt( f, t, y, dt, k1 );
+        }
+
+        // Integrates t and y up to t1. On failure t and y hold the last
+        // accepted state.
+        template<typename F>
+        [[nodiscard]] ode_status integrate( F&& f, time<T>& t, State& y, time<T> t1 )
+        {
+            // first same as last, k7 of an accepted step is k1 of the next
+            derivative k1 = f( t, y );
+            std::size_t rejections = 0;
+            while ( t < t1 )
+            {
+                // the final step is shortened to land on t1, this should
+                // not shrink the step size carried into the next call
+                const time<T> remaining = t1 - t;
+                const bool last = remaining < dt;
+                const time<T> h = last ? remaining : dt;
+                const time<T> adapted = dt;
+                if ( t + h == t )
+                    return ode_status::step_underflow;
+                if ( attempt( f, t, y, h, k1 ) )
+                {
+                    rejections = 0;
+                    if ( last )
+                    {
+                        t = t1;
+                        dt = adapted;
+                    }
+                }
+                else if ( h <= min_dt )
+                    return ode_status::step_underflow;
+                else if ( ++rejections >= max_rejections )
+                    return ode_status::too_many_rejections;
+            }
+            return ode_status::ok;
+        }
+
+    private:
+        // k1 is f(t, y) and is replaced by f(t + h, y5) when the step is accepted
+        template<typename F>
+        bool attempt( F& f, time<T>& t, State& y, time<T> h, derivative& k1 )
+        {
+            using tableau = detail::dormand_prince_tableau<T>;
+
+            const derivative k2 = f( t + tableau::c2 * h, detail::ode_map( [&]( auto y0, auto q1 ) {
+                return y0 + ( tableau::a21 * q1 ) * h;
+            }, y, k1 ) );
+            const derivative k3 = f( t + tableau::c3 * h, detail::ode_map( [&]( auto y0, auto q1, auto q2 ) {
+                return y0 + ( tableau::a31 * q1 + tableau::a32 * q2 ) * h;
+            }, y, k1, k2 ) );
+            const derivative k4 = f( t + tableau::c4 * h, detail::ode_map( [&]( auto y0, auto q1, auto q2, auto q3 ) {
+                return y0 + ( tableau::a41 * q1 + tableau::a42 * q2 + tableau::a43 * q3 ) * h;
+            }, y, k1, k2, k3 ) );
+            const derivative k5 = f( t + tableau::c5 * h, detail::ode_map( [&]( auto y0, auto q1, auto q2, auto q3, auto q4 ) {
+                return y0 + ( tableau::a51 * q1 + tableau::a52 * q2 + tableau::a53 * q3 + tableau::a54 * q4 ) * h;
+            }, y, k1, k2, k3, k4 ) );
+            const derivative k6 = f( t + h, detail::ode_map( [&]( auto y0, auto q1, auto q2, auto q3, auto q4, auto q5 ) {
+                return y0 + ( tableau::a61 * q1 + tableau::a62 * q2 + tableau::a63 * q3 + tableau::a64 * q4 + tableau::a65 * q5 ) * h;
+            }, y, k1, k2, k3, k4, k5 ) );
+            const State y5 = detail::ode_map( [&]( auto y0, auto q1, auto q3, auto q4, auto q5, auto q6 ) {
+                return y0 + ( tableau::b1 * q1 + tableau::b3 * q3 + tableau::b4 * q4 + tableau::b5 * q5 + tableau::b6 * q6 ) * h;
+            }, y, k1, k3, k4, k5, k6 );
+            const derivative k7 = f( t + h, y5 );
+
+            // RMS of error / tolerance over every leaf, a dimensionless number
+            T sum = T(0);
+            std::size_t count = 0;
+            detail::ode_for_each( [&]( auto y0, auto y1, auto tolerance, auto q1, auto q3, auto q4, auto q5, auto q6, auto q7 ) {
+                const auto error = ( tableau::e1 * q1 + tableau::e3 * q3 + tableau::e4 * q4 + tableau::e5 * q5 + tableau::e6 * q6 + tableau::e7 * q7 ) * h;
+                const auto magnitude = abs( y0 ) < abs( y1 ) ? abs( y1 ) : abs( y0 );
+                const T ratio = error / ( tolerance + relative_tolerance * magnitude );
+                sum += ratio * ratio;
+                count++;
+            }, y, y5, absolute_tolerance, k1, k3, k4, k5, k6, k7 );
+            const T norm = std::sqrt( sum / static_cast<T>( count ) );
+
+            // a non-finite error is never accepted and shrinks the step as much as allowed
+            const bool finite = std::isfinite( norm );
+            const bool accepted = finite && ( norm <= T(1) || h <= min_dt );
+
+            // standard step size controller, 0.9 safety factor and growth limited to [0.2, 5]
+            const T factor = !finite ? T(0.2) : norm == T(0) ? T(5) : std::clamp( T(0.9) * std::pow( norm, T(-0.2) ), T(0.2), T(5) );
+            time<T> next = h * factor;
+            if ( next < min_dt ) next = min_dt;
+            if ( next > max_dt ) next = max_dt;
+            dt = next;
+
+            if ( accepted )
+            {
+                t += h;
+                y = y5;
+                k1 = k7;
+                accepted_steps++;
+            }
+            else
+            {
+                rejected_steps++;
+            }
+            return accepted;
+        }
+    };
+
+    // Fourth order Runge-Kutta over an ensemble of independent systems stored
+    // as columns (struct of arrays), one std::span per state variable.
+    // f is called as f(time<T>, std::tuple<std::span<const Qtys>...> y, std::tuple<std::span<derivative_of<Qtys>>...> dydt)
+    // and should fill dydt for every system in y, each call only sees a
+    // contiguous slice of the ensemble.
+    template<detail::qty_type... Qtys>
+    struct rk4_ensemble
+    {
+        using T = typename std::tuple_element_t<0, std::tuple<Qtys...>>::type;
+        using columns = std::tuple<std::span<Qtys>...>;
+        using const_columns = std::tuple<std::span<const Qtys>...>;
+        using derivative_columns = std::tuple<std::span<derivative_of<Qtys>>...>;
+
+        // Steps every system by dt.
+        template<typename F>
+        void step( F&& f, time<T> t, columns y, time<T> dt )
+        {
+            const std::size_t count = std::get<0>( y ).size();
+            reserve( count );
+            step_range( f, t, y, dt, 0, count );
+        }
+
+        // Steps every system by dt, splitting the ensemble into contiguous
+        // chunks over threads. f must be safe to call concurrently.
+        template<typename F>
+        void step( F&& f, time<T> t, columns y, time<T> dt, std::size_t threads )
+        {
+            const std::size_t count = std::get<0>( y ).size();
+            reserve( count );
+            threads = std::max<std::size_t>( 1, std::min( threads, count ) );
+
+            const std::size_t chunk = ( count + threads - 1 ) / threads;
+            std::vector<std::jthread> workers;
+            workers.reserve( threads );
+            for ( std::size_t start = 0; start < count; start += chunk )
+            {
+                const std::size_t size = std::min( chunk, count - start );
+                workers.emplace_back( [&f, t, y, dt, start, size, this]() { step_range( f, t, y, dt, start, size ); } );
+            }
+        }
+
+    private:
+        template<typename F>
+        void step_range( F& f, time<T> t, columns y_all, time<T> dt, std::size_t offset, std::size_t count )
+        {
+            const time<T> half = dt * T(0.5);
+            const time<T> sixth = dt / T(6);
+
+            [&]<std::size_t... I>( std::index_sequence<I...> ) {
+                const columns y{ std::get<I>( y_all ).subspan( offset, count )... };
+                const columns stage{ std::span( std::get<I>( stage_storage ) ).subspan( offset, count )... };
+                const derivative_columns k{ std::span( std::get<I>( k_storage ) ).subspan( offset, count )... };
+                const derivative_columns sum{ std::span( std::get<I>( sum_storage ) ).subspan( offset, count )... };
+                const const_columns y_read{ std::get<I>( y )... };
+                const const_columns stage_read{ std::get<I>( stage )... };
+
+                // each line below is one vectorisable loop per column
+                f( t, y_read, k );
+                ( assign_sum( std::get<I>( sum ), std::get<I>( k ) ), ... );
+                ( axpy( std::get<I>( stage ), std::get<I>( y ), std::get<I>( k ), half ), ... );
+
+                f( t + half, stage_read, k );
+                ( accumulate( std::get<I>( sum ), std::get<I>( k ), T(2) ), ... );
+                ( axpy( std::get<I>( stage ), std::get<I>( y ), std::get<I>( k ), half ), ... );
+
+                f( t + half, stage_read, k );
+                ( accumulate( std::get<I>( sum ), std::get<I>( k ), T(2) ), ... );
+                ( axpy( std::get<I>( stage ), std::get<I>( y ), std::get<I>( k ), dt ), ... );
+
+                f( t + dt, stage_read, k );
+                ( accumulate( std::get<I>( sum ), std::get<I>( k ), T(1) ), ... );
+                ( axpy( std::get<I>( y ), std::get<I>( y ), std::get<I>( sum ), sixth ), ... );
+            }( std::index_sequence_for<Qtys...>{} );
+        }
+
+        void reserve( std::size_t count )
+        {
+            std::apply( [count]( auto&... column ) { ( column.resize( count ), ... ); }, stage_storage );
+            std::apply( [count]( auto&... column ) { ( column.resize( count ), ... ); }, k_storage );
+            std::apply( [count]( auto&... column ) { ( column.resize( count ), ... ); }, sum_storage );
+        }
+
+        template<typename Qty, typename Derivative>
+        static void axpy( std::span<Qty> out, std::span<Qty> y, std::span<Derivative> k, time<T> h ) noexcept
+        {
+            for ( std::size_t i = 0; i < out.size(); i++ )
+                out[i] = y[i] + k[i] * h;
+        }
+
+        template<typename Derivative>
+        static void assign_sum( std::span<Derivative> sum, std::span<Derivative> k ) noexcept
+        {
+            for ( std::size_t i = 0; i < sum.size(); i++ )
+                sum[i] = k[i];
+        }
+
+        template<typename Derivative>
+        static void accumulate( std::span<Derivative> sum, std::span<Derivative> k, T weight ) noexcept
+        {
+            for ( std::size_t i = 0; i < sum.size(); i++ )
+                sum[i] += weight * k[i];
+        }
+
+        std::tuple<std::vector<Qtys>...> stage_storage;
+        std::tuple<std::vector<derivative_of<Qtys>>...> k_storage;
+        std::tuple<std::vector<derivative_of<Qtys>>...> sum_storage;
+    };
+}
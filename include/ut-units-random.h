@@ -0,0 +1,271 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+
+namespace ut
+{
+    // splitmix64 as a counter based generator, every output is a pure
+    // function of the seed and its position so fill() has no loop carried
+    // dependency and vectorises.
+    // https://prng.di.unimi.it/splitmix64.c
+    struct splitmix64
+    {
+        using result_type = std::uint64_t;
+
+        static constexpr std::uint64_t gamma = 0x9e3779b97f4a7c15ull;
+
+        constexpr explicit splitmix64( std::uint64_t seed = 0 ) noexcept : state( seed ) {}
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+        [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        [[nodiscard]] static constexpr std::uint64_t mix( std::uint64_t z ) noexcept
+        {
+            z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+            z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebull;
+            return z ^ ( z >> 31 );
+        }
+
+        constexpr result_type operator()() noexcept
+        {
+            state += gamma;
+            return mix( state );
+        }
+
+        // Writes the next out.size() outputs, identical to calling operator() that many times.
+        constexpr void fill( std::span<std::uint64_t> out ) noexcept
+        {
+            const std::uint64_t base = state;
+            const std::size_t count = out.size();
+            for ( std::size_t i = 0; i < count; i++ )
+                out[i] = mix( base + ( i + 1 ) * gamma );
+            state = base + count * gamma;
+        }
+
+        std::uint64_t state;
+    };
+} // end namespace ut
+
+namespace ut::detail
+{
+    // Generators which produce all 64 random bits per call, these can be
+    // mapped to floating point without going through std::generate_canonical.
+    template<typename Gen>
+    concept full_range_64bit_generator = requires() {
+        requires std::uniform_random_bit_generator<Gen>;
+        requires std::same_as<typename Gen::result_type, std::uint64_t>;
+        requires Gen::min() == 0;
+        requires Gen::max() == std::numeric_limits<std::uint64_t>::max();
+    };
+
+    template<typename Gen>
+    concept bulk_generator = requires( Gen& gen, std::span<std::uint64_t> out ) {
+        requires full_range_64bit_generator<Gen>;
+        { gen.fill( out ) };
+    };
+
+    inline constexpr std::size_t random_block_size = 256;
+
+    template<typename Gen>
+    UT_UNITS_CRITICAL_INLINE void generate_bits( Gen& gen, std::span<std::uint64_t> out )
+    {
+        if constexpr ( bulk_generator<Gen> )
+            gen.fill( out );
+        else
+            for ( std::uint64_t& bits : out )
+                bits = gen();
+    }
+
+    // Maps random bits to [0,1) using the top mantissa-width bits.
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T unit_interval( std::uint64_t bits ) noexcept
+    {
+        constexpr int digits = std::numeric_limits<T>::digits;
+        return static_cast<T>( bits >> ( 64 - digits ) ) * ( T(1) / static_cast<T>( std::uint64_t(1) << digits ) );
+    }
+
+    // unit with its scalars converted to T, so value * unit keeps the distribution's scalar type
+    template<std::floating_point T, std::floating_point Ty, qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> random_unit( qty<Ty,dimensions> unit ) noexcept
+    {
+        return unit.template cast<T>();
+    }
+
+    template<std::floating_point T, std::floating_point Ty, qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty_offset<T,dimensions> random_unit( qty_offset<Ty,dimensions> unit ) noexcept
+    {
+        return qty_offset<T,dimensions>{ T( unit.value ), T( unit.offset ) };
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Uniform distribution over [a, b) of a quantity, results are in SI.
+    template<detail::qty_type Qty>
+    struct uniform_qty_distribution
+    {
+        using result_type = Qty;
+        using T = typename Qty::type;
+        using dimensions = typename Qty::dimensions;
+
+        uniform_qty_distribution() : uniform_qty_distribution( Qty{ 0 }, Qty{ 1 } ) {}
+
+        template<detail::mixed_qty<Qty> TyA, detail::mixed_qty<Qty> TyB>
+        uniform_qty_distribution( TyA a, TyB b ) : distribution( T( a.value ), T( b.value ) ) {}
+
+        // Range given as scalars of unit, e.g. (-10.0, 30.0, ut::celsius)
+        template<std::floating_point Ty>
+        uniform_qty_distribution( T a, T b, qty<Ty,dimensions> unit ) : uniform_qty_distribution( a * detail::random_unit<T>( unit ), b * detail::random_unit<T>( unit ) ) {}
+        template<std::floating_point Ty>
+        uniform_qty_distribution( T a, T b, qty_offset<Ty,dimensions> unit ) : uniform_qty_distribution( a * detail::random_unit<T>( unit ), b * detail::random_unit<T>( unit ) ) {}
+
+        template<typename Gen>
+        [[nodiscard]] result_type operator()( Gen& gen )
+        {
+            result_type result;
+            result.value = distribution( gen );
+            return result;
+        }
+
+        // Fills out with independent samples. Generators producing 64 random
+        // bits per call take a branch free path, generators with a
+        // fill(std::span<std::uint64_t>) member (ut::splitmix64) also fill in bulk.
+        template<typename Gen>
+        void fill( Gen& gen, std::span<Qty> out )
+        {
+            if constexpr ( detail::full_range_64bit_generator<Gen> )
+            {
+                const T lower = distribution.a();
+                const T range = distribution.b() - distribution.a();
+                std::uint64_t bits[detail::random_block_size];
+                for ( std::size_t start = 0; start < out.size(); start += detail::random_block_size )
+                {
+                    const std::size_t count = std::min( detail::random_block_size, out.size() - start );
+                    detail::generate_bits( gen, std::span( bits, count ) );
+                    Qty* block = out.data() + start;
+                    for ( std::size_t i = 0; i < count; i++ )
+                        block[i].value = lower + range * detail::unit_interval<T>( bits[i] );
+                }
+            }
+            else
+            {
+                for ( Qty& value : out )
+                    value = (*this)( gen );
+            }
+        }
+
+        void reset() { distribution.reset(); }
+
+        [[nodiscard]] result_type a() const { return result_type{ distribution.a() }; }
+        [[nodiscard]] result_type b() const { return result_type{ distribution.b() }; }
+        [[nodiscard]] result_type min() const { return a(); }
+        [[nodiscard]] result_type max() const { return b(); }
+
+        std::uniform_real_distribution<T> distribution;
+    };
+
+    // Normal distribution of a quantity, results are in SI.
+    template<detail::qty_type Qty>
+    struct normal_qty_distribution
+    {
+        using result_type = Qty;
+        using T = typename Qty::type;
+        using dimensions = typename Qty::dimensions;
+
+        normal_qty_distribution() : normal_qty_distribution( Qty{ 0 }, Qty{ 1 } ) {}
+
+        template<detail::mixed_qty<Qty> TyMean, detail::mixed_qty<Qty> TyStddev>
+        normal_qty_distribution( TyMean mean, TyStddev stddev ) : distribution( T( mean.value ), T( stddev.value ) ) {}
+
+        // Mean and standard deviation given as scalars of unit. For offset
+        // units (ut::celsius) the offset only applies to the mean, the standard
+        // deviation is a difference and is only scaled.
+        template<std::floating_point Ty>
+        normal_qty_distribution( T mean, T stddev, qty<Ty,dimensions> unit ) : normal_qty_distribution( mean * detail::random_unit<T>( unit ), stddev * detail::random_unit<T>( unit ) ) {}
+        template<std::floating_point Ty>
+        normal_qty_distribution( T mean, T stddev, qty_offset<Ty,dimensions> unit ) : distribution( ( mean * detail::random_unit<T>( unit ) ).value, stddev * T( unit.value ) ) {}
+
+        template<typename Gen>
+        [[nodiscard]] result_type operator()( Gen& gen )
+        {
+            result_type result;
+            result.value = distribution( gen );
+            return result;
+        }
+
+        // Fills out with independent samples using Box-Muller on pairs of
+        // uniforms. Draws a different (equally distributed) sequence to
+        // operator(). See uniform_qty_distribution::fill for generator requirements.
+        template<typename Gen>
+        void fill( Gen& gen, std::span<Qty> out )
+        {
+            if constexpr ( detail::full_range_64bit_generator<Gen> )
+            {
+                constexpr T two_pi = T(2) * std::numbers::pi_v<T>;
+                const T mean = distribution.mean();
+                const T stddev = distribution.stddev();
+                std::uint64_t bits[detail::random_block_size];
+                for ( std::size_t start = 0; start < out.size(); start += detail::random_block_size )
+                {
+                    const std::size_t count = std::min( detail::random_block_size, out.size() - start );
+                    const std::size_t pairs = ( count + 1 ) / 2;
+                    detail::generate_bits( gen, std::span( bits, pairs * 2 ) );
+
+                    T block[detail::random_block_size];
+                    for ( std::size_t i = 0; i < pairs; i++ )
+                    {
+                        // 1 - u is in (0,1] so the log is finite
+                        const T radius = std::sqrt( T(-2) * std::log( T(1) - detail::unit_interval<T>( bits[i] ) ) );
+                        const T theta = two_pi * detail::unit_interval<T>( bits[pairs + i] );
+                        block[i] = mean + stddev * radius * std::cos( theta );
+                        block[pairs + i] = mean + stddev * radius * std::sin( theta );
+                    }
+
+                    Qty* destination = out.data() + start;
+                    for ( std::size_t i = 0; i < count; i++ )
+                        destination[i].value = block[i];
+                }
+            }
+            else
+            {
+                for ( Qty& value : out )
+                    value = (*this)( gen );
+            }
+        }
+
+        void reset() { distribution.reset(); }
+
+        [[nodiscard]] result_type mean() const { return result_type{ distribution.mean() }; }
+        [[nodiscard]] result_type stddev() const { return result_type{ distribution.stddev() }; }
+
+        std::normal_distribution<T> distribution;
+    };
+}
@@ -0,0 +1,297 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace ut
+{
+    enum class resample_mode
+    {
+        zero_order_hold,        // the last sample at or before the output time
+        linear,                 // linear between the samples either side
+        windowed_sinc           // Blackman windowed sinc, low pass at the lower of the two Nyquist rates
+    };
+
+    // Timestamped samples of one quantity waiting to be resampled. Times must increase.
+    template<detail::qty_type Qty>
+    struct resample_channel
+    {
+        using T = typename Qty::type;
+
+        void push( time<T> t, Qty value )
+        {
+            assert( times.empty() || t.value > times.back().value );
+            times.push_back( t );
+            values.push_back( value );
+        }
+
+        void push( std::span<const time<T>> t, std::span<const Qty> value )
+        {
+            assert( t.size() == value.size() );
+            assert( t.empty() || times.empty() || t.front().value > times.back().value );
+            times.insert( times.end(), t.begin(), t.end() );
+            values.insert( values.end(), value.begin(), value.end() );
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return times.size(); }
+
+        std::vector<time<T>> times;
+        std::vector<Qty> values;
+
+        // windowed sinc samples either side of an output, fixed from the first
+        // samples so results do not depend on how the stream was chunked
+        std::size_t taps = 0;
+
+        // scratch for process, per output the last sample at or before it, the
+        // values either side and the position between them
+        std::vector<std::size_t> lower;
+        std::vector<T> before;
+        std::vector<T> after;
+        std::vector<T> fraction;
+    };
+
+    // Aligns channels of different quantities sampled at their own, possibly
+    // irregular, times onto one time base at rate. Samples are pushed into
+    // channel<I>() as they arrive and process() emits every output which
+    // all channels have enough samples for, so unbounded streams are
+    // resampled incrementally. Samples no longer needed are dropped.
+    template<detail::qty_type... Qtys>
+    struct resampler
+    {
+        using T = typename std::tuple_element_t<0, std::tuple<Qtys...>>::type;
+        static_assert( ( std::same_as<typename Qtys::type, T> && ... ), "every channel must have the same scalar type" );
+
+        explicit resampler( frequency<T> rate, resample_mode mode = resample_mode::linear, std::size_t half_width = 8 ) noexcept :
+            rate( rate ), mode( mode ), half_width( std::max<std::size_t>( 1, half_width ) ) {}
+
+        template<std::size_t I>
+        [[nodiscard]] auto& channel() noexcept { return std::get<I>( channels ); }
+
+        // Appends the ready output times to times and the resampled values of
+        // each channel to out. The first output is at the latest first sample
+        // of the channels. Returns the number of outputs.
+        std::size_t process( std::vector<time<T>>& times, std::vector<Qtys>&... out )
+        {
+            return [&]<std::size_t... I>( std::index_sequence<I...> ) -> std::size_t {
+                if ( ( std::get<I>( channels ).times.empty() || ... ) )
+                    return 0;
+                if ( mode == resample_mode::windowed_sinc )
+                    ( fix_taps( std::get<I>( channels ) ), ... );
+                if ( !started )
+                {
+                    start = std::max( { std::get<I>( channels ).times.front()... }, []( time<T> a, time<T> b ) { return a.value < b.value; } );
+                    started = true;
+                }
+
+                const std::size_t count = std::min( { ready( std::get<I>( channels ) )... } );
+                if ( count == 0 )
+                    return 0;
+
+                const std::size_t first = times.size();
+                for ( std::size_t k = 0; k < count; k++ )
+                    times.push_back( time_at( emitted + k ) );
+                const std::span<const time<T>> output_times( times.data() + first, count );
+
+                std::tuple<std::vector<Qtys>&...> outs{ out... };
+                ( resample( std::get<I>( channels ), output_times, std::get<I>( outs ) ), ... );
+                emitted += count;
+                ( trim( std::get<I>( channels ) ), ... );
+                return count;
+            }( std::index_sequence_for<Qtys...>{} );
+        }
+
+        frequency<T> rate;
+        resample_mode mode;
+        std::size_t half_width;     // windowed sinc half width in output periods, in input samples when upsampling
+        std::tuple<resample_channel<Qtys>...> channels;
+
+        time<T> start{ T(0) };
+        std::size_t emitted = 0;
+        bool started = false;
+
+    private:
+        // Output k is at start + k / rate, computed directly so it does not drift
+        [[nodiscard]] time<T> time_at( std::size_t k ) const noexcept
+        {
+            return time<T>{ start.value + T(k) / rate.value };
+        }
+
+        // When downsampling the sinc lobes widen by 1 / ratio input samples, the
+        // taps widen with them so the low pass keeps its stop band. The ratio
+        // is taken from the first half_width + 1 samples of the channel.
+        template<typename Channel>
+        void fix_taps( Channel& channel ) const noexcept
+        {
+            if ( channel.taps != 0 || channel.size() <= half_width )
+                return;
+            const T period = ( channel.times[half_width].value - channel.times.front().value ) / T( half_width );
+            const T ratio = std::min( T(1), rate.value * period );
+            channel.taps = std::max( half_width, std::size_t( std::ceil( T( half_width ) / ratio ) ) );
+        }
+
+        // Outputs this channel has enough samples for. Zero order hold and linear
+        // need a sample at or after the output time, windowed sinc needs
+        // taps samples after it.
+        template<typename Channel>
+        [[nodiscard]] std::size_t ready( const Channel& channel ) const noexcept
+        {
+            const std::size_t n = channel.size();
+            const bool sinc = mode == resample_mode::windowed_sinc;
+            if ( sinc && ( channel.taps == 0 || n <= channel.taps ) )
+                return 0;
+
+            const T limit = sinc ? channel.times[n - channel.taps].value : channel.times.back().value;
+            const auto in_range = [&]( std::size_t k ) { return sinc ? time_at( k ).value < limit : time_at( k ).value <= limit; };
+
+            if ( !in_range( emitted ) )
+                return 0;
+            std::size_t k = std::max( emitted, std::size_t( std::max( T(0), std::floor( ( limit - start.value ) * rate.value ) ) ) );
+            while ( k > emitted && !in_range( k ) )
+                k--;
+            while ( in_range( k + 1 ) )
+                k++;
+            return k + 1 - emitted;
+        }
+
+        template<typename Qty>
+        void resample( resample_channel<Qty>& channel, std::span<const time<T>> output_times, std::vector<Qty>& out )
+        {
+            const std::size_t count = output_times.size();
+            const std::size_t n = channel.size();
+            channel.lower.resize( count );
+            channel.before.resize( count );
+            channel.after.resize( count );
+            channel.fraction.resize( count );
+
+            // merge the sorted output times with the sample times and gather
+            // the samples either side, the kernels below then read contiguously
+            std::size_t j = 0;
+            for ( std::size_t k = 0; k < count; k++ )
+            {
+                const T t = output_times[k].value;
+                while ( j < n && channel.times[j].value <= t )
+                    j++;
+                const std::size_t lower = j - 1;
+                const std::size_t upper = std::min( j, n - 1 );
+                const T gap = channel.times[upper].value - channel.times[lower].value;
+                channel.lower[k] = lower;
+                channel.before[k] = channel.values[lower].value;
+                channel.after[k] = channel.values[upper].value;
+                channel.fraction[k] = gap > T(0) ? ( t - channel.times[lower].value ) / gap : T(0);
+            }
+
+            const std::size_t first = out.size();
+            out.resize( first + count );
+            Qty* destination = out.data() + first;
+            const T* before = channel.before.data();
+            const T* after = channel.after.data();
+            const T* fraction = channel.fraction.data();
+
+            switch ( mode )
+            {
+            case resample_mode::zero_order_hold:
+                for ( std::size_t k = 0; k < count; k++ )
+                    destination[k].value = before[k];
+                break;
+            case resample_mode::linear:
+                for ( std::size_t k = 0; k < count; k++ )
+                    destination[k].value = before[k] + fraction[k] * ( after[k] - before[k] );
+                break;
+            case resample_mode::windowed_sinc:
+                sinc( channel, output_times, destination );
+                break;
+            }
+        }
+
+        // The sample period is taken from the taps of each output and weights
+        // are normalised by their sum, so irregular sample spacing and the
+        // start of the stream, where taps are missing, keep unity gain. The tap
+        // loop is branch free, it vectorises where the compiler has vector math
+        // functions and may reassociate the sums.
+        template<typename Qty>
+        void sinc( const resample_channel<Qty>& channel, std::span<const time<T>> output_times, Qty* destination ) const noexcept
+        {
+            constexpr T pi = std::numbers::pi_v<T>;
+            const std::size_t n = channel.size();
+            const T inverse_width = T(1) / T( half_width );
+
+            for ( std::size_t k = 0; k < output_times.size(); k++ )
+            {
+                const T t = output_times[k].value;
+                const std::size_t i = channel.lower[k];
+                const std::size_t first = i + 1 >= channel.taps ? i + 1 - channel.taps : 0;
+                const std::size_t last = std::min( i + channel.taps, n - 1 );
+                if ( first == last )
+                {
+                    destination[k].value = channel.values[first].value;
+                    continue;
+                }
+
+                const T period = ( channel.times[last].value - channel.times[first].value ) / T( last - first );
+                const T inverse_period = T(1) / period;
+                const T ratio = std::min( T(1), rate.value * period );
+
+                T sum = T(0);
+                T weights = T(0);
+                for ( std::size_t j = first; j <= last; j++ )
+                {
+                    const T x = ( t - channel.times[j].value ) * inverse_period;
+                    const T u = std::min( std::abs( x ) * ratio * inverse_width, T(1) );
+                    const T window = T(0.42) + T(0.5) * std::cos( pi * u ) + T(0.08) * std::cos( T(2) * pi * u );
+                    // px is nudged off zero rather than branching, sin(e)/e rounds to 1
+                    T px = pi * ratio * x;
+                    px = std::abs( px ) < T(1e-6) ? T(1e-6) : px;
+                    const T kernel = std::sin( px ) / px;
+                    const T weight = kernel * window;
+                    sum += weight * channel.values[j].value;
+                    weights += weight;
+                }
+                destination[k].value = sum / weights;
+            }
+        }
+
+        // Drops samples before those the next output needs
+        template<typename Qty>
+        void trim( resample_channel<Qty>& channel )
+        {
+            const T next = time_at( emitted ).value;
+            const auto after = std::upper_bound( channel.times.begin(), channel.times.end(), next,
+                []( T t, time<T> sample ) { return t < sample.value; } );
+            std::size_t lower = std::size_t( after - channel.times.begin() );
+            lower = lower > 0 ? lower - 1 : 0;
+            const std::size_t keep = mode == resample_mode::windowed_sinc ? ( lower + 1 >= channel.taps ? lower + 1 - channel.taps : 0 ) : lower;
+
+            channel.times.erase( channel.times.begin(), channel.times.begin() + keep );
+            channel.values.erase( channel.values.begin(), channel.values.begin() + keep );
+        }
+    };
+} // end namespace ut
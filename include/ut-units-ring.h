@@ -0,0 +1,260 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+
+#ifndef UT_UNITS_RING_CACHE_LINE
+#   define UT_UNITS_RING_CACHE_LINE 64
+#endif
+
+namespace ut::detail
+{
+    template<typename T>
+    inline constexpr bool is_qty_tuple = false;
+
+    template<typename... Ty>
+    inline constexpr bool is_qty_tuple<std::tuple<Ty...>> = ( qty_type<Ty> && ... );
+
+    // A quantity or a tuple of quantities, e.g. a timestamped sample
+    template<typename T>
+    concept ring_value = qty_type<T> || is_qty_tuple<T>;
+
+    // Index owned by one side of a ring on its own cache line, together with
+    // that side's last seen value of the other side's index.
+    struct alignas(UT_UNITS_RING_CACHE_LINE) ring_index
+    {
+        std::atomic<std::size_t> index{ 0 };
+        std::size_t cached = 0;
+    };
+
+    [[nodiscard]] inline std::size_t ring_capacity( std::size_t capacity ) noexcept
+    {
+        return std::bit_ceil( std::max<std::size_t>( capacity, 2 ) );
+    }
+
+    // Copies count values starting at position of a power of two ring, in at most two runs
+    template<typename Value>
+    UT_UNITS_CRITICAL_INLINE void ring_copy_in( Value* slots, std::size_t mask, std::size_t position, const Value* values, std::size_t count ) noexcept
+    {
+        const std::size_t first = std::min( count, mask + 1 - ( position & mask ) );
+        std::copy_n( values, first, slots + ( position & mask ) );
+        std::copy_n( values + first, count - first, slots );
+    }
+
+    template<typename Value>
+    UT_UNITS_CRITICAL_INLINE void ring_copy_out( const Value* slots, std::size_t mask, std::size_t position, Value* values, std::size_t count ) noexcept
+    {
+        const std::size_t first = std::min( count, mask + 1 - ( position & mask ) );
+        std::copy_n( slots + ( position & mask ), first, values );
+        std::copy_n( slots, count - first, values + first );
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Bounded lock free single producer single consumer queue. Capacity is
+    // rounded up to a power of two. push and pop never block, they return
+    // false (or the number of values transferred) when full or empty.
+    template<detail::ring_value Value>
+    struct spsc_ring
+    {
+        using value_type = Value;
+
+        explicit spsc_ring( std::size_t capacity )
+            : mask( detail::ring_capacity( capacity ) - 1 ), slots( std::make_unique<Value[]>( mask + 1 ) )
+        {
+        }
+
+        spsc_ring( const spsc_ring& ) = delete;
+        spsc_ring& operator=( const spsc_ring& ) = delete;
+
+        // Producer only
+        [[nodiscard]] bool push( const Value& value ) noexcept
+        {
+            const std::size_t tail = producer.index.load( std::memory_order_relaxed );
+            if ( tail - producer.cached > mask )
+            {
+                producer.cached = consumer.index.load( std::memory_order_acquire );
+                if ( tail - producer.cached > mask )
+                    return false;
+            }
+            slots[tail & mask] = value;
+            producer.index.store( tail + 1, std::memory_order_release );
+            return true;
+        }
+
+        // Producer only, pushes as many of values as fit and returns how many
+        [[nodiscard]] std::size_t push( std::span<const Value> values ) noexcept
+        {
+            const std::size_t tail = producer.index.load( std::memory_order_relaxed );
+            if ( mask + 1 - ( tail - producer.cached ) < values.size() )
+                producer.cached = consumer.index.load( std::memory_order_acquire );
+
+            const std::size_t count = std::min( values.size(), mask + 1 - ( tail - producer.cached ) );
+            detail::ring_copy_in( slots.get(), mask, tail, values.data(), count );
+            producer.index.store( tail + count, std::memory_order_release );
+            return count;
+        }
+
+        // Consumer only
+        [[nodiscard]] bool pop( Value& value ) noexcept
+        {
+            const std::size_t head = consumer.index.load( std::memory_order_relaxed );
+            if ( head == consumer.cached )
+            {
+                consumer.cached = producer.index.load( std::memory_order_acquire );
+                if ( head == consumer.cached )
+                    return false;
+            }
+            value = slots[head & mask];
+            consumer.index.store( head + 1, std::memory_order_release );
+            return true;
+        }
+
+        // Consumer only, pops up to values.size() values and returns how many
+        [[nodiscard]] std::size_t pop( std::span<Value> values ) noexcept
+        {
+            const std::size_t head = consumer.index.load( std::memory_order_relaxed );
+            if ( consumer.cached - head < values.size() )
+                consumer.cached = producer.index.load( std::memory_order_acquire );
+
+            const std::size_t count = std::min( values.size(), consumer.cached - head );
+            detail::ring_copy_out( slots.get(), mask, head, values.data(), count );
+            consumer.index.store( head + count, std::memory_order_release );
+            return count;
+        }
+
+        // Approximate when called concurrently
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return producer.index.load( std::memory_order_acquire ) - consumer.index.load( std::memory_order_acquire );
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask + 1; }
+
+    private:
+        detail::ring_index producer;
+        detail::ring_index consumer;
+        std::size_t mask;
+        std::unique_ptr<Value[]> slots;
+    };
+
+    // Bounded lock free multiple producer single consumer queue. Producers
+    // claim slots with a compare and swap on the tail and publish each slot
+    // through its sequence number, so the consumer only sees complete values.
+    template<detail::ring_value Value>
+    struct mpsc_ring
+    {
+        using value_type = Value;
+
+        explicit mpsc_ring( std::size_t capacity )
+            : mask( detail::ring_capacity( capacity ) - 1 ), slots( std::make_unique<slot[]>( mask + 1 ) )
+        {
+        }
+
+        mpsc_ring( const mpsc_ring& ) = delete;
+        mpsc_ring& operator=( const mpsc_ring& ) = delete;
+
+        // Any thread
+        [[nodiscard]] bool push( const Value& value ) noexcept
+        {
+            return push( std::span<const Value>( &value, 1 ) ) == 1;
+        }
+
+        // Any thread, the pushed values are contiguous in the queue
+        [[nodiscard]] std::size_t push( std::span<const Value> values ) noexcept
+        {
+            std::size_t tail = producer.index.load( std::memory_order_relaxed );
+            std::size_t count;
+            do
+            {
+                // slots before the consumer's head have been read and are free
+                const std::size_t head = consumer.index.load( std::memory_order_acquire );
+                count = std::min( values.size(), mask + 1 - ( tail - head ) );
+                if ( count == 0 )
+                    return 0;
+            }
+            while ( !producer.index.compare_exchange_weak( tail, tail + count, std::memory_order_relaxed ) );
+
+            for ( std::size_t i = 0; i < count; i++ )
+            {
+                slot& destination = slots[( tail + i ) & mask];
+                destination.value = values[i];
+                destination.sequence.store( tail + i + 1, std::memory_order_release );
+            }
+            return count;
+        }
+
+        // Consumer only
+        [[nodiscard]] bool pop( Value& value ) noexcept
+        {
+            return pop( std::span<Value>( &value, 1 ) ) == 1;
+        }
+
+        // Consumer only, pops up to values.size() values which are ready and returns how many
+        [[nodiscard]] std::size_t pop( std::span<Value> values ) noexcept
+        {
+            const std::size_t head = consumer.index.load( std::memory_order_relaxed );
+            std::size_t count = 0;
+            for ( ; count < values.size(); count++ )
+            {
+                const slot& source = slots[( head + count ) & mask];
+                if ( source.sequence.load( std::memory_order_acquire ) != head + count + 1 )
+                    break;
+                values[count] = source.value;
+            }
+            consumer.index.store( head + count, std::memory_order_release );
+            return count;
+        }
+
+        // Approximate when called concurrently, includes claimed values not yet published
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return producer.index.load( std::memory_order_acquire ) - consumer.index.load( std::memory_order_acquire );
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask + 1; }
+
+    private:
+        struct slot
+        {
+            std::atomic<std::size_t> sequence{ 0 };
+            Value value;
+        };
+
+        detail::ring_index producer;
+        detail::ring_index consumer;
+        std::size_t mask;
+        std::unique_ptr<slot[]> slots;
+    };
+} // end namespace ut
@@ -0,0 +1,271 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef UT_UNITS_SOA_ALIGNMENT
+#   define UT_UNITS_SOA_ALIGNMENT 64
+#endif
+
+// Lists the members of State which ut::soa stores as columns, use at global scope.
+//  UT_UNITS_SOA_FIELDS(State, position, velocity, mass);
+#define UT_UNITS_SOA_FIELDS(State, ...) \
+    template<> struct ut::soa_fields<State> { \
+        static constexpr auto members = std::tuple{ UT_UNITS_SOA_MEMBERS(State, __VA_ARGS__) }; \
+    }
+
+#define UT_UNITS_SOA_EXPAND(x) x
+#define UT_UNITS_SOA_CAT(a, b) UT_UNITS_SOA_CAT_I(a, b)
+#define UT_UNITS_SOA_CAT_I(a, b) a##b
+#define UT_UNITS_SOA_COUNT(...) UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_COUNT_N(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define UT_UNITS_SOA_COUNT_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define UT_UNITS_SOA_MEMBERS(S, ...) UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_CAT(UT_UNITS_SOA_M, UT_UNITS_SOA_COUNT(__VA_ARGS__))(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M1(S, a) &S::a
+#define UT_UNITS_SOA_M2(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M1(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M3(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M2(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M4(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M3(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M5(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M4(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M6(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M5(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M7(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M6(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M8(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M7(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M9(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M8(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M10(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M9(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M11(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M10(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M12(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M11(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M13(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M12(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M14(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M13(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M15(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M14(S, __VA_ARGS__))
+#define UT_UNITS_SOA_M16(S, a, ...) &S::a, UT_UNITS_SOA_EXPAND(UT_UNITS_SOA_M15(S, __VA_ARGS__))
+
+namespace ut
+{
+    // Specialise (or use UT_UNITS_SOA_FIELDS) with a static constexpr tuple of
+    // member pointers named members.
+    template<typename State>
+    struct soa_fields;
+}
+
+namespace ut::detail
+{
+    template<typename T, std::size_t Alignment>
+    struct aligned_allocator
+    {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = aligned_allocator<U,Alignment>; };
+
+        aligned_allocator() noexcept = default;
+
+        template<typename U>
+        aligned_allocator( const aligned_allocator<U,Alignment>& ) noexcept {}
+
+        [[nodiscard]] T* allocate( std::size_t n )
+        {
+            return static_cast<T*>( ::operator new( n * sizeof(T), std::align_val_t{ Alignment } ) );
+        }
+
+        void deallocate( T* pointer, std::size_t ) noexcept
+        {
+            ::operator delete( pointer, std::align_val_t{ Alignment } );
+        }
+
+        template<typename U>
+        bool operator==( const aligned_allocator<U,Alignment>& ) const noexcept { return true; }
+    };
+
+    template<typename T>
+    using soa_column = std::vector<T, aligned_allocator<T, UT_UNITS_SOA_ALIGNMENT>>;
+
+    template<typename T>
+    struct member_pointer_traits;
+
+    template<typename Class, typename Member>
+    struct member_pointer_traits<Member Class::*>
+    {
+        using class_type = Class;
+        using member_type = Member;
+    };
+
+    template<typename State>
+    using soa_members = std::remove_cvref_t<decltype(soa_fields<State>::members)>;
+
+    template<typename Members>
+    struct soa_columns_s;
+
+    template<typename... Members>
+    struct soa_columns_s<std::tuple<Members...>>
+    {
+        using type = std::tuple<soa_column<typename member_pointer_traits<Members>::member_type>...>;
+    };
+
+    template<typename State>
+    using soa_columns = soa_columns_s<soa_members<State>>::type;
+
+    // Index of Member within soa_fields<State>::members or the member count if it is not listed.
+    template<typename State, auto Member, std::size_t I = 0>
+    consteval std::size_t soa_index()
+    {
+        constexpr auto& members = soa_fields<State>::members;
+        if constexpr ( I == std::tuple_size_v<soa_members<State>> )
+            return I;
+        else if constexpr ( std::same_as<std::remove_cvref_t<decltype(std::get<I>(members))>, decltype(Member)> )
+            return std::get<I>(members) == Member ? I : soa_index<State,Member,I + 1>();
+        else
+            return soa_index<State,Member,I + 1>();
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Struct of arrays container. Each member of State listed in soa_fields
+    // is stored in its own contiguous aligned column so kernels which touch a
+    // single member only stream that member through the cache.
+    template<typename State>
+    struct soa
+    {
+        using members = detail::soa_members<State>;
+        static constexpr std::size_t member_count = std::tuple_size_v<members>;
+
+        template<auto Member>
+        using member_type = detail::member_pointer_traits<decltype(Member)>::member_type;
+
+        template<auto Member>
+        static constexpr std::size_t index_of()
+        {
+            constexpr std::size_t index = detail::soa_index<State,Member>();
+            static_assert( index < member_count, "member is not listed in ut::soa_fields for this State" );
+            return index;
+        }
+
+        // Proxy for one element, reads and writes go directly to the columns.
+        template<bool Const>
+        struct basic_reference
+        {
+            using container = std::conditional_t<Const, const soa, soa>;
+
+            template<auto Member>
+            [[nodiscard]] auto& get() const noexcept
+            {
+                return std::get<index_of<Member>()>( owner->columns )[index];
+            }
+
+            [[nodiscard]] operator State() const
+            {
+                return owner->load( index );
+            }
+
+            const basic_reference& operator=( const State& state ) const requires( ! Const )
+            {
+                owner->store( index, state );
+                return *this;
+            }
+
+            container* owner;
+            std::size_t index;
+        };
+
+        using reference = basic_reference<false>;
+        using const_reference = basic_reference<true>;
+
+        [[nodiscard]] std::size_t size() const noexcept { return std::get<0>( columns ).size(); }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        void reserve( std::size_t count )
+        {
+            std::apply( [count]( auto&... column ) { ( column.reserve( count ), ... ); }, columns );
+        }
+
+        void resize( std::size_t count )
+        {
+            std::apply( [count]( auto&... column ) { ( column.resize( count ), ... ); }, columns );
+        }
+
+        void clear() noexcept
+        {
+            std::apply( []( auto&... column ) { ( column.clear(), ... ); }, columns );
+        }
+
+        void push_back( const State& state )
+        {
+            push_back( state, std::make_index_sequence<member_count>{} );
+        }
+
+        [[nodiscard]] State load( std::size_t index ) const
+        {
+            return load( index, std::make_index_sequence<member_count>{} );
+        }
+
+        void store( std::size_t index, const State& state )
+        {
+            store( index, state, std::make_index_sequence<member_count>{} );
+        }
+
+        [[nodiscard]] reference operator[]( std::size_t index ) noexcept { return { this, index }; }
+        [[nodiscard]] const_reference operator[]( std::size_t index ) const noexcept { return { this, index }; }
+
+        // Returns the whole column of Member, e.g. column<&State::velocity>()
+        template<auto Member>
+        [[nodiscard]] std::span<member_type<Member>> column() noexcept
+        {
+            return std::get<index_of<Member>()>( columns );
+        }
+
+        template<auto Member>
+        [[nodiscard]] std::span<const member_type<Member>> column() const noexcept
+        {
+            return std::get<index_of<Member>()>( columns );
+        }
+
+        detail::soa_columns<State> columns;
+
+    private:
+        template<std::size_t... I>
+        void push_back( const State& state, std::index_sequence<I...> )
+        {
+            ( std::get<I>( columns ).push_back( state.*std::get<I>( soa_fields<State>::members ) ), ... );
+        }
+
+        template<std::size_t... I>
+        State load( std::size_t index, std::index_sequence<I...> ) const
+        {
+            State state{};
+            ( ( state.*std::get<I>( soa_fields<State>::members ) = std::get<I>( columns )[index] ), ... );
+            return state;
+        }
+
+        template<std::size_t... I>
+        void store( std::size_t index, const State& state, std::index_sequence<I...> )
+        {
+            ( ( std::get<I>( columns )[index] = state.*std::get<I>( soa_fields<State>::members ) ), ... );
+        }
+    };
+}
@@ -0,0 +1,343 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ut
+{
+    // k-d tree over points whose coordinates are quantities, e.g. positions as
+    // ut::length triples. Points are split at the median of the widest axis
+    // into leaves of up to leaf_size points, every node keeps the bounding box
+    // of its points and queries prune on the boxes. Because pruning does not
+    // depend on the split planes, moved points only need the boxes refit.
+    template<detail::qty_type Qty, std::size_t N = 3>
+    struct kd_tree
+    {
+        using T = typename Qty::type;
+        using point_type = std::array<Qty,N>;
+
+        struct neighbour
+        {
+            std::size_t index;
+            Qty distance;
+        };
+
+        static constexpr std::size_t leaf_size = 8;
+
+        // Builds over points, queries return indices into points. Subtrees
+        // are built in parallel over up to threads threads.
+        void build( std::span<const point_type> points, std::size_t threads = 1 )
+        {
+            positions.assign( points.begin(), points.end() );
+            rebuild( threads );
+        }
+
+        // Sets the position of one point, call refit() before querying.
+        void move( std::size_t index, const point_type& position ) noexcept
+        {
+            positions[index] = position;
+        }
+
+        // Replaces every position, the point count must not change.
+        bool update( std::span<const point_type> points, std::size_t threads = 1 )
+        {
+            assert( points.size() == positions.size() );
+            std::copy( points.begin(), points.end(), positions.begin() );
+            return refit( threads );
+        }
+
+        // Recomputes the bounding boxes after points moved, which is linear in
+        // the point count. Rebuilds instead when the leaf boxes have grown by
+        // more than rebuild_ratio since the last build. Returns true if rebuilt.
+        // Does nothing before the first build().
+        bool refit( std::size_t threads = 1 )
+        {
+            if ( lower.empty() )
+                return false;
+            if ( refit_measure() > rebuild_ratio * built_measure )
+            {
+                rebuild( threads );
+                return true;
+            }
+            return false;
+        }
+
+        // Appends the index of every point within radius of centre to out.
+        template<detail::mixed_qty<Qty> TyRadius>
+        void within( const point_type& centre, TyRadius radius, std::vector<std::size_t>& out ) const
+        {
+            if ( positions.empty() )
+                return;
+            const T r = T( radius.value );
+            within_node( 0, 0, values( centre ), r * r, out );
+        }
+
+        // The k nearest points to centre, nearest first.
+        void nearest( const point_type& centre, std::size_t k, std::vector<neighbour>& out ) const
+        {
+            out.clear();
+            if ( positions.empty() || k == 0 )
+                return;
+
+            std::vector<std::pair<T,std::size_t>> heap;
+            heap.reserve( k );
+            nearest_node( 0, 0, values( centre ), k, heap );
+            std::sort_heap( heap.begin(), heap.end() );
+            for ( const auto& [distance2, index] : heap )
+                out.push_back( { index, Qty{ std::sqrt( distance2 ) } } );
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return positions.size(); }
+
+        T rebuild_ratio = T(2);
+
+        std::vector<point_type> positions;
+        std::vector<std::size_t> order;
+        std::vector<std::array<T,N>> lower;
+        std::vector<std::array<T,N>> upper;
+        std::size_t depth = 0;
+        T built_measure = T(0);
+
+    private:
+        [[nodiscard]] static std::array<T,N> values( const point_type& point ) noexcept
+        {
+            std::array<T,N> result;
+            for ( std::size_t axis = 0; axis < N; axis++ )
+                result[axis] = point[axis].value;
+            return result;
+        }
+
+        void rebuild( std::size_t threads )
+        {
+            const std::size_t count = positions.size();
+            depth = 0;
+            while ( ( count + ( std::size_t(1) << depth ) - 1 ) >> depth > leaf_size )
+                depth++;
+
+            const std::size_t nodes = ( std::size_t(2) << depth ) - 1;
+            lower.assign( nodes, {} );
+            upper.assign( nodes, {} );
+            order.resize( count );
+            std::iota( order.begin(), order.end(), std::size_t(0) );
+            build_node( 0, 0, 0, count, std::max<std::size_t>( 1, threads ) );
+            built_measure = leaf_measure();
+        }
+
+        // Node i at level covers order[begin, end), children are 2i+1 and 2i+2
+        void build_node( std::size_t i, std::size_t level, std::size_t begin, std::size_t end, std::size_t threads )
+        {
+            fit_leaf( i, begin, end );
+            if ( level == depth )
+                return;
+
+            std::size_t axis = 0;
+            for ( std::size_t a = 1; a < N; a++ )
+                if ( upper[i][a] - lower[i][a] > upper[i][axis] - lower[i][axis] )
+                    axis = a;
+
+            const std::size_t middle = begin + ( end - begin ) / 2;
+            std::nth_element( order.begin() + begin, order.begin() + middle, order.begin() + end,
+                [this, axis]( std::size_t a, std::size_t b ) { return positions[a][axis].value < positions[b][axis].value; } );
+
+            if ( threads > 1 )
+            {
+                std::jthread left( [this, i, level, begin, middle, threads]() { build_node( 2 * i + 1, level + 1, begin, middle, threads / 2 ); } );
+                build_node( 2 * i + 2, level + 1, middle, end, threads - threads / 2 );
+            }
+            else
+            {
+                build_node( 2 * i + 1, level + 1, begin, middle, 1 );
+                build_node( 2 * i + 2, level + 1, middle, end, 1 );
+            }
+        }
+
+        // Leaves keep the ranges of order they had at build time
+        [[nodiscard]] T refit_measure()
+        {
+            refit_node( 0, 0, 0, positions.size() );
+            return leaf_measure();
+        }
+
+        void refit_node( std::size_t i, std::size_t level, std::size_t begin, std::size_t end )
+        {
+            if ( level == depth )
+            {
+                fit_leaf( i, begin, end );
+                return;
+            }
+            const std::size_t middle = begin + ( end - begin ) / 2;
+            refit_node( 2 * i + 1, level + 1, begin, middle );
+            refit_node( 2 * i + 2, level + 1, middle, end );
+            for ( std::size_t axis = 0; axis < N; axis++ )
+            {
+                lower[i][axis] = std::min( lower[2 * i + 1][axis], lower[2 * i + 2][axis] );
+                upper[i][axis] = std::max( upper[2 * i + 1][axis], upper[2 * i + 2][axis] );
+            }
+        }
+
+        // Empty ranges get an inverted box which every query prunes
+        void fit_leaf( std::size_t i, std::size_t begin, std::size_t end ) noexcept
+        {
+            lower[i].fill( std::numeric_limits<T>::infinity() );
+            upper[i].fill( -std::numeric_limits<T>::infinity() );
+            for ( std::size_t p = begin; p < end; p++ )
+            {
+                for ( std::size_t axis = 0; axis < N; axis++ )
+                {
+                    lower[i][axis] = std::min( lower[i][axis], positions[order[p]][axis].value );
+                    upper[i][axis] = std::max( upper[i][axis], positions[order[p]][axis].value );
+                }
+            }
+        }
+
+        // Sum of the leaf box extents
+        [[nodiscard]] T leaf_measure() const noexcept
+        {
+            T measure = T(0);
+            const std::size_t first = ( std::size_t(1) << depth ) - 1;
+            for ( std::size_t i = first; i < lower.size(); i++ )
+                for ( std::size_t axis = 0; axis < N; axis++ )
+                    if ( upper[i][axis] >= lower[i][axis] )
+                        measure += upper[i][axis] - lower[i][axis];
+            return measure;
+        }
+
+        [[nodiscard]] T box_distance2( std::size_t i, const std::array<T,N>& centre ) const noexcept
+        {
+            T distance2 = T(0);
+            for ( std::size_t axis = 0; axis < N; axis++ )
+            {
+                const T d = std::max( { lower[i][axis] - centre[axis], T(0), centre[axis] - upper[i][axis] } );
+                distance2 += d * d;
+            }
+            return distance2;
+        }
+
+        [[nodiscard]] T far_distance2( std::size_t i, const std::array<T,N>& centre ) const noexcept
+        {
+            T distance2 = T(0);
+            for ( std::size_t axis = 0; axis < N; axis++ )
+            {
+                const T d = std::max( centre[axis] - lower[i][axis], upper[i][axis] - centre[axis] );
+                distance2 += d * d;
+            }
+            return distance2;
+        }
+
+        [[nodiscard]] T point_distance2( std::size_t index, const std::array<T,N>& centre ) const noexcept
+        {
+            T distance2 = T(0);
+            for ( std::size_t axis = 0; axis < N; axis++ )
+            {
+                const T d = positions[index][axis].value - centre[axis];
+                distance2 += d * d;
+            }
+            return distance2;
+        }
+
+        [[nodiscard]] std::pair<std::size_t,std::size_t> range( std::size_t i, std::size_t level ) const noexcept
+        {
+            // walk down from the root, the path to node i is in its index bits
+            std::size_t begin = 0;
+            std::size_t end = positions.size();
+            const std::size_t offset = i + 1 - ( std::size_t(1) << level );
+            for ( std::size_t l = level; l > 0; l-- )
+            {
+                const std::size_t middle = begin + ( end - begin ) / 2;
+                if ( ( offset >> ( l - 1 ) ) & 1 )
+                    begin = middle;
+                else
+                    end = middle;
+            }
+            return { begin, end };
+        }
+
+        void within_node( std::size_t i, std::size_t level, const std::array<T,N>& centre, T radius2, std::vector<std::size_t>& out ) const
+        {
+            if ( !( lower[i][0] <= upper[i][0] ) || box_distance2( i, centre ) > radius2 )
+                return;
+
+            const bool inside = far_distance2( i, centre ) <= radius2;
+            if ( inside || level == depth )
+            {
+                const auto [begin, end] = range( i, level );
+                for ( std::size_t p = begin; p < end; p++ )
+                    if ( inside || point_distance2( order[p], centre ) <= radius2 )
+                        out.push_back( order[p] );
+                return;
+            }
+            within_node( 2 * i + 1, level + 1, centre, radius2, out );
+            within_node( 2 * i + 2, level + 1, centre, radius2, out );
+        }
+
+        void nearest_node( std::size_t i, std::size_t level, const std::array<T,N>& centre, std::size_t k, std::vector<std::pair<T,std::size_t>>& heap ) const
+        {
+            if ( level == depth )
+            {
+                const auto [begin, end] = range( i, level );
+                for ( std::size_t p = begin; p < end; p++ )
+                {
+                    const T distance2 = point_distance2( order[p], centre );
+                    if ( heap.size() < k )
+                    {
+                        heap.emplace_back( distance2, order[p] );
+                        std::push_heap( heap.begin(), heap.end() );
+                    }
+                    else if ( distance2 < heap.front().first )
+                    {
+                        std::pop_heap( heap.begin(), heap.end() );
+                        heap.back() = { distance2, order[p] };
+                        std::push_heap( heap.begin(), heap.end() );
+                    }
+                }
+                return;
+            }
+
+            std::size_t near = 2 * i + 1;
+            std::size_t far = 2 * i + 2;
+            T near2 = box_distance2( near, centre );
+            T far2 = box_distance2( far, centre );
+            if ( far2 < near2 )
+            {
+                std::swap( near, far );
+                std::swap( near2, far2 );
+            }
+            if ( heap.size() < k || near2 < heap.front().first )
+                nearest_node( near, level + 1, centre, k, heap );
+            if ( heap.size() < k || far2 < heap.front().first )
+                nearest_node( far, level + 1, centre, k, heap );
+        }
+    };
+} // end namespace ut
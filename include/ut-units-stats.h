@@ -0,0 +1,375 @@
+/*
+MIT License
+
+Copyright (c) 2026 Joshua Nelson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include "ut-units.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ut::detail
+{
+    inline constexpr std::size_t stats_block_size = 256;
+
+    // Dense run of logarithmic bucket counts starting at bucket index offset.
+    // When it would exceed max_buckets the lowest buckets are collapsed into
+    // one, so accuracy is only lost for the smallest magnitudes.
+    struct sketch_store
+    {
+        int offset = 0;
+        std::vector<std::uint64_t> counts;
+
+        void add( int index, std::uint64_t count, std::size_t max_buckets )
+        {
+            if ( counts.empty() )
+            {
+                offset = index;
+                counts.push_back( 0 );
+            }
+            else if ( index < offset )
+            {
+                // at capacity anything lower is counted in the lowest bucket
+                const std::size_t grow = std::min( static_cast<std::size_t>( offset - index ), max_buckets - std::min( max_buckets, counts.size() ) );
+                counts.insert( counts.begin(), grow, 0 );
+                offset -= static_cast<int>( grow );
+                index = std::max( index, offset );
+            }
+            else if ( static_cast<std::size_t>( index - offset ) >= counts.size() )
+            {
+                counts.resize( static_cast<std::size_t>( index - offset ) + 1, 0 );
+                collapse( max_buckets );
+                index = std::max( index, offset );
+            }
+            counts[static_cast<std::size_t>( index - offset )] += count;
+        }
+
+        void collapse( std::size_t max_buckets )
+        {
+            if ( counts.size() <= max_buckets )
+                return;
+            const std::size_t excess = counts.size() - max_buckets;
+            std::uint64_t lowest = 0;
+            for ( std::size_t i = 0; i <= excess; i++ )
+                lowest += counts[i];
+            counts.erase( counts.begin(), counts.begin() + static_cast<std::ptrdiff_t>( excess ) );
+            counts[0] = lowest;
+            offset += static_cast<int>( excess );
+        }
+
+        void merge( const sketch_store& other, std::size_t max_buckets )
+        {
+            for ( std::size_t i = 0; i < other.counts.size(); i++ )
+                if ( other.counts[i] != 0 )
+                    add( other.offset + static_cast<int>( i ), other.counts[i], max_buckets );
+        }
+    };
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Mergeable quantile sketch with relative error guarantee (DDSketch).
+    // Magnitudes are counted in logarithmic buckets so any estimated quantile
+    // is within relative_accuracy of a true sample value of that rank.
+    // https://arxiv.org/abs/1908.10693
+    template<detail::qty_type Qty>
+    struct quantile_sketch
+    {
+        using T = typename Qty::type;
+
+        explicit quantile_sketch( T relative_accuracy = T(0.01), std::size_t max_buckets = 2048 )
+            : relative_accuracy( relative_accuracy ),
+              gamma( ( T(1) + relative_accuracy ) / ( T(1) - relative_accuracy ) ),
+              inverse_log_gamma( T(1) / std::log( gamma ) ),
+              max_buckets( max_buckets )
+        {
+            assert( relative_accuracy > T(0) && relative_accuracy < T(1) );
+        }
+
+        void add( Qty value )
+        {
+            insert( value.value, index( bucket_magnitude( value.value ) ) );
+        }
+
+        void add( std::span<const Qty> values )
+        {
+            int indices[detail::stats_block_size];
+            for ( std::size_t start = 0; start < values.size(); start += detail::stats_block_size )
+            {
+                const std::size_t block_count = std::min( detail::stats_block_size, values.size() - start );
+                const Qty* block = values.data() + start;
+
+                // logarithms for the whole block first, this loop has no dependencies
+                for ( std::size_t i = 0; i < block_count; i++ )
+                    indices[i] = index( bucket_magnitude( block[i].value ) );
+
+                for ( std::size_t i = 0; i < block_count; i++ )
+                    insert( block[i].value, indices[i] );
+            }
+        }
+
+        void merge( const quantile_sketch& other )
+        {
+            assert( other.gamma == gamma );
+            positive.merge( other.positive, max_buckets );
+            negative.merge( other.negative, max_buckets );
+            zero_count += other.zero_count;
+            negative_infinity_count += other.negative_infinity_count;
+            positive_infinity_count += other.positive_infinity_count;
+            nan_count += other.nan_count;
+        }
+
+        // Number of ordered values, NaN is only counted in nan_count
+        [[nodiscard]] std::uint64_t count() const noexcept
+        {
+            std::uint64_t total = zero_count + negative_infinity_count + positive_infinity_count;
+            for ( const std::uint64_t bucket : positive.counts )
+                total += bucket;
+            for ( const std::uint64_t bucket : negative.counts )
+                total += bucket;
+            return total;
+        }
+
+        // Estimated value at quantile q in [0,1], zero when empty
+        [[nodiscard]] Qty quantile( T q ) const
+        {
+            const std::uint64_t total = count();
+            if ( total == 0 )
+                return Qty{ T(0) };
+
+            const T rank = std::clamp( q, T(0), T(1) ) * static_cast<T>( total - 1 );
+            std::uint64_t seen = negative_infinity_count;
+            if ( static_cast<T>( seen ) > rank )
+                return Qty{ -std::numeric_limits<T>::infinity() };
+
+            // most negative first
+            for ( std::size_t i = negative.counts.size(); i-- > 0; )
+            {
+                seen += negative.counts[i];
+                if ( static_cast<T>( seen ) > rank )
+                    return Qty{ -value( negative.offset + static_cast<int>( i ) ) };
+            }
+
+            seen += zero_count;
+            if ( static_cast<T>( seen ) > rank )
+                return Qty{ T(0) };
+
+            for ( std::size_t i = 0; i < positive.counts.size(); i++ )
+            {
+                seen += positive.counts[i];
+                if ( static_cast<T>( seen ) > rank )
+                    return Qty{ value( positive.offset + static_cast<int>( i ) ) };
+            }
+
+            if ( positive_infinity_count > 0 )
+                return Qty{ std::numeric_limits<T>::infinity() };
+            return Qty{ value( positive.offset + static_cast<int>( positive.counts.size() ) - 1 ) };
+        }
+
+        void clear()
+        {
+            positive = {};
+            negative = {};
+            zero_count = 0;
+            negative_infinity_count = 0;
+            positive_infinity_count = 0;
+            nan_count = 0;
+        }
+
+        T relative_accuracy;
+        T gamma;
+        T inverse_log_gamma;
+        std::size_t max_buckets;
+
+        detail::sketch_store positive;
+        detail::sketch_store negative;
+        std::uint64_t zero_count = 0;
+        std::uint64_t negative_infinity_count = 0;
+        std::uint64_t positive_infinity_count = 0;
+        std::uint64_t nan_count = 0;
+
+    private:
+        // Magnitude to take the logarithm of, values without a bucket use the
+        // smallest normal so the index is always representable
+        [[nodiscard]] static T bucket_magnitude( T value ) noexcept
+        {
+            const T magnitude = std::abs( value );
+            return std::isfinite( magnitude ) && magnitude >= std::numeric_limits<T>::min() ? magnitude : std::numeric_limits<T>::min();
+        }
+
+        void insert( T value, int bucket )
+        {
+            const T magnitude = std::abs( value );
+            if ( std::isnan( value ) )
+                nan_count++;
+            else if ( !( magnitude >= std::numeric_limits<T>::min() ) )
+                zero_count++;
+            else if ( std::isinf( value ) )
+                ( value > T(0) ? positive_infinity_count : negative_infinity_count )++;
+            else if ( value > T(0) )
+                positive.add( bucket, 1, max_buckets );
+            else
+                negative.add( bucket, 1, max_buckets );
+        }
+
+        [[nodiscard]] int index( T magnitude ) const noexcept
+        {
+            return static_cast<int>( std::ceil( std::log( magnitude ) * inverse_log_gamma ) );
+        }
+
+        // Bucket i holds (gamma^(i-1), gamma^i], this estimate is within relative_accuracy of both ends
+        [[nodiscard]] T value( int bucket ) const noexcept
+        {
+            return T(2) * std::pow( gamma, static_cast<T>( bucket ) ) / ( gamma + T(1) );
+        }
+    };
+
+    // Single pass statistics of a quantity stream: Welford mean and variance,
+    // minimum, maximum and quantiles from a quantile_sketch. Instances can be
+    // filled independently (e.g. per thread) and merged.
+    template<detail::qty_type Qty>
+    struct stats
+    {
+        using T = typename Qty::type;
+        using dimensions = typename Qty::dimensions;
+        using variance_type = detail::qty_pow<2,T,dimensions>;
+
+        explicit stats( T relative_accuracy = T(0.01) ) : sketch( relative_accuracy ) {}
+
+        void add( Qty value )
+        {
+            count++;
+            const Qty delta = value - mean;
+            mean += delta / static_cast<T>( count );
+            m2 += delta * ( value - mean );
+            minimum.value = std::min( minimum.value, value.value );
+            maximum.value = std::max( maximum.value, value.value );
+            sketch.add( value );
+        }
+
+        // Moments of each block are computed with a two pass loop which
+        // vectorises, then combined with the running moments as in merge().
+        void add( std::span<const Qty> values )
+        {
+            for ( std::size_t start = 0; start < values.size(); start += detail::stats_block_size )
+            {
+                const std::size_t block_count = std::min( detail::stats_block_size, values.size() - start );
+                const Qty* block = values.data() + start;
+
+                T sum = T(0);
+                T lowest = minimum.value;
+                T highest = maximum.value;
+                for ( std::size_t i = 0; i < block_count; i++ )
+                {
+                    sum += block[i].value;
+                    lowest = std::min( lowest, block[i].value );
+                    highest = std::max( highest, block[i].value );
+                }
+
+                const T block_mean = sum / static_cast<T>( block_count );
+                T block_m2 = T(0);
+                for ( std::size_t i = 0; i < block_count; i++ )
+                {
+                    const T delta = block[i].value - block_mean;
+                    block_m2 += delta * delta;
+                }
+
+                combine( block_count, block_mean, block_m2 );
+                minimum.value = lowest;
+                maximum.value = highest;
+            }
+            sketch.add( values );
+        }
+
+        // Chan et al. parallel combination of moments
+        void merge( const stats& other )
+        {
+            combine( other.count, other.mean.value, other.m2.value );
+            minimum.value = std::min( minimum.value, other.minimum.value );
+            maximum.value = std::max( maximum.value, other.maximum.value );
+            sketch.merge( other.sketch );
+        }
+
+        // Population variance, zero when empty
+        [[nodiscard]] variance_type variance() const noexcept
+        {
+            return count > 0 ? m2 / static_cast<T>( count ) : variance_type{ T(0) };
+        }
+
+        // Unbiased sample variance, zero with fewer than two samples
+        [[nodiscard]] variance_type sample_variance() const noexcept
+        {
+            return count > 1 ? m2 / static_cast<T>( count - 1 ) : variance_type{ T(0) };
+        }
+
+        [[nodiscard]] Qty stddev() const noexcept
+        {
+            return ut::sqrt( variance() );
+        }
+
+        // Estimated quantile, exact at 0 (minimum) and 1 (maximum)
+        [[nodiscard]] Qty quantile( T q ) const
+        {
+            if ( count == 0 )
+                return Qty{ T(0) };
+            if ( q <= T(0) )
+                return minimum;
+            if ( q >= T(1) )
+                return maximum;
+            return Qty{ std::clamp( sketch.quantile( q ).value, minimum.value, maximum.value ) };
+        }
+
+        void clear()
+        {
+            count = 0;
+            mean = Qty{ T(0) };
+            m2 = variance_type{ T(0) };
+            minimum = Qty{ std::numeric_limits<T>::infinity() };
+            maximum = Qty{ -std::numeric_limits<T>::infinity() };
+            sketch.clear();
+        }
+
+        std::uint64_t count = 0;
+        Qty mean{ T(0) };
+        variance_type m2{ T(0) };
+        Qty minimum{ std::numeric_limits<T>::infinity() };
+        Qty maximum{ -std::numeric_limits<T>::infinity() };
+        quantile_sketch<Qty> sketch;
+
+    private:
+        void combine( std::uint64_t other_count, T other_mean, T other_m2 ) noexcept
+        {
+            if ( other_count == 0 )
+                return;
+            const T total = static_cast<T>( count + other_count );
+            const T delta = other_mean - mean.value;
+            mean.value += delta * ( static_cast<T>( other_count ) / total );
+            m2.value += other_m2 + delta * delta * ( static_cast<T>( count ) * static_cast<T>( other_count ) / total );
+            count += other_count;
+        }
+    };
+} // end namespace ut
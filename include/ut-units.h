@@ -22,9 +22,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
+#include <array>
 #include <concepts>
 #include <numbers>
 #include <cmath>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #ifndef UT_UNITS_CRITICAL_INLINE
 #   if defined(_MSC_VER)
@@ -36,6 +41,19 @@ SOFTWARE.
 #   endif
 #endif
 
+// Define UT_UNITS_FP_INSTRUMENTATION (project wide) to count denormal, NaN,
+// Inf and divide by zero results of the qty operators. When it is not defined
+// the checks expand to nothing.
+#ifdef UT_UNITS_FP_INSTRUMENTATION
+#   include <atomic>
+#   include <cstdio>
+#   define UT_UNITS_FP_CHECK(op, result) ::ut::detail::fp_check<op>(result)
+#   define UT_UNITS_FP_CHECK_DIVISOR(result, divisor) ::ut::detail::fp_check_divisor(result, divisor)
+#else
+#   define UT_UNITS_FP_CHECK(op, result) ((void)0)
+#   define UT_UNITS_FP_CHECK_DIVISOR(result, divisor) ((void)0)
+#endif
+
 namespace ut::detail
 {
     template<typename T>
@@ -95,6 +113,28 @@ namespace ut::detail
             T::d_candela  % 2 == 0;
     };
 
+    template<int N, int D, qty_dimensions_type T>
+    struct rational_powable
+    {
+        static_assert(D != 0, "Denominator of rational power cannot be zero");
+        static_assert(T::d_second   * N % D == 0 , "Time dimension not raisable to this rational power");
+        static_assert(T::d_metre    * N % D == 0 , "Length dimension not raisable to this rational power");
+        static_assert(T::d_kilogram * N % D == 0 , "Mass dimension not raisable to this rational power");
+        static_assert(T::d_ampere   * N % D == 0 , "Current dimension not raisable to this rational power");
+        static_assert(T::d_kelvin   * N % D == 0 , "Temperature dimension not raisable to this rational power");
+        static_assert(T::d_mole     * N % D == 0 , "Amount dimension not raisable to this rational power");
+        static_assert(T::d_candela  * N % D == 0 , "Luminosity dimension not raisable to this rational power");
+        static constexpr bool value = 
+            D != 0 &&
+            T::d_second   * N % D == 0 &&
+            T::d_metre    * N % D == 0 &&
+            T::d_kilogram * N % D == 0 &&
+            T::d_ampere   * N % D == 0 &&
+            T::d_kelvin   * N % D == 0 &&
+            T::d_mole     * N % D == 0 &&
+            T::d_candela  * N % D == 0;
+    };
+
     template<typename T1, typename T2>
     concept compatible_qty = requires() {
 requires qty_type<T1>;
@@ -103,9 +143,33 @@ requires qty_type<T1>;
         requires same_dimensions<typename T1::dimensions, typename T2::dimensions>::value;
     };
 
+    // As compatible_qty but the scalar types may differ, e.g. float storage
+    // with double constants. Results use the common (wider) scalar type.
+    template<typename T1, typename T2>
+    concept mixed_qty = requires() {
+        requires qty_type<T1>;
+        requires qty_type<T2>;
+        requires same_dimensions<typename T1::dimensions, typename T2::dimensions>::value;
+    };
+
+    template<typename T1, typename T2>
+    using common_scalar = std::common_type_t<typename T1::type, typename T2::type>;
+
     template<typename>
     struct always_false { static constexpr bool value = false; };
 
+    // Exponents of the seven base dimensions in the order s, m, kg, A, K, mol, cd,
+    // the runtime form used by serialised and parsed units
+    template<qty_dimensions_type dimensions>
+    [[nodiscard]] constexpr std::array<std::int8_t,7> dimension_exponents() noexcept
+    {
+        return {
+            std::int8_t( dimensions::d_second ), std::int8_t( dimensions::d_metre ), std::int8_t( dimensions::d_kilogram ),
+            std::int8_t( dimensions::d_ampere ), std::int8_t( dimensions::d_kelvin ), std::int8_t( dimensions::d_mole ),
+            std::int8_t( dimensions::d_candela )
+        };
+    }
+
 } // end namespace ut::detail
 
 namespace ut
@@ -148,8 +212,9 @@ namespace ut
         // stored in base SI units
         T value;
 
+        template<std::floating_point Ty>
         [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T in( 
-            const qty_offset<T,dimensions>& other
+            const qty_offset<Ty,dimensions>& other
         ) const noexcept;
 
         // This is only for dimensionless quantities
@@ -174,8 +239,13 @@ namespace ut
             static_assert( detail::always_false<qty<Ty,other_dims>>::value, "assignment failed - this operator is never valid" );
         }
 
-        template<detail::compatible_qty<qty> Ty>
-        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T in( const Ty& other ) const noexcept { return value / other.value; }
+        // other may have another scalar type, the ratio is computed in the common type
+        template<detail::mixed_qty<qty> Ty>
+        [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T in( const Ty& other ) const noexcept
+        {
+            using common = std::common_type_t<T, typename Ty::type>;
+            return T( common( value ) / common( other.value ) );
+        }
 
         // Convert to Specific Scalar but Keep the Unit
         // returns qty<Ty,dimensions>
@@ -206,9 +276,11 @@ namespace ut
     };
 
     template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    UT_UNITS_CRITICAL_INLINE constexpr T qty<T,dimensions>::in( const qty_offset<T,dimensions>& other) const noexcept
+    template<std::floating_point Ty>
+    UT_UNITS_CRITICAL_INLINE constexpr T qty<T,dimensions>::in( const qty_offset<Ty,dimensions>& other) const noexcept
     {
-        return (value / other.value) - other.offset;
+        using common = std::common_type_t<T, Ty>;
+        return T( (common(value) / common(other.value)) - common(other.offset) );
     }
 
 } // end namespace ut
@@ -296,6 +368,27 @@ namespace ut::detail
     template<int N, std::floating_point T, detail::qty_dimensions_type dimensions>
     using qty_pow = qty_pow_s<N,T,dimensions>::value;
 
+    template<int N, int D, std::floating_point T, detail::qty_dimensions_type dimensions>
+    requires(detail::rational_powable<N,D,dimensions>::value)
+    struct qty_rational_pow_s
+    {
+        using value = qty<
+            T,
+            qty_dimensions<
+                dimensions::d_second    * N / D,
+                dimensions::d_metre     * N / D,
+                dimensions::d_kilogram  * N / D,
+                dimensions::d_ampere    * N / D,
+                dimensions::d_kelvin    * N / D,
+                dimensions::d_mole      * N / D,
+                dimensions::d_candela   * N / D
+            >
+        >;
+    };
+
+    template<int N, int D, std::floating_point T, detail::qty_dimensions_type dimensions>
+    using qty_rational_pow = qty_rational_pow_s<N,D,T,dimensions>::value;
+
     template<typename T>
     struct qty_offset_to_qty_s
     {
@@ -309,106 +402,284 @@ namespace ut::detail
     using qty_offset_to_qty = qty_offset_to_qty_s<T>::type;
 } // end namespace detail
 
+#ifdef UT_UNITS_FP_INSTRUMENTATION
+namespace ut // floating point hazard instrumentation
+{
+    enum class fp_operator { add, subtract, multiply, divide };
+
+    // Snapshot of the hazard counters for one dimension and operator pair.
+    struct fp_hazard_counts
+    {
+        std::uint64_t denormal = 0;
+        std::uint64_t nan = 0;
+        std::uint64_t inf = 0;
+        std::uint64_t divide_by_zero = 0;
+    };
+} // end namespace ut
+
+namespace ut::detail
+{
+    struct fp_record
+    {
+        int dimensions[7];
+        fp_operator op;
+        std::atomic<std::uint64_t> denormal{0};
+        std::atomic<std::uint64_t> nan{0};
+        std::atomic<std::uint64_t> inf{0};
+        std::atomic<std::uint64_t> divide_by_zero{0};
+        fp_record* next = nullptr;
+    };
+
+    // Intrusive list of every record that has been touched, used for reporting.
+    inline std::atomic<fp_record*> fp_records{nullptr};
+
+    // Records are created on first use so only the dimensions which actually
+    // produce hazards (or are queried) end up in the report.
+    template<qty_dimensions_type dimensions, fp_operator op>
+    fp_record& fp_record_for() noexcept
+    {
+        static fp_record* record = [] {
+            static fp_record storage{
+                .dimensions = {
+                    dimensions::d_second,
+                    dimensions::d_metre,
+                    dimensions::d_kilogram,
+                    dimensions::d_ampere,
+                    dimensions::d_kelvin,
+                    dimensions::d_mole,
+                    dimensions::d_candela
+                },
+                .op = op
+            };
+            storage.next = fp_records.load(std::memory_order_relaxed);
+            while ( ! fp_records.compare_exchange_weak(storage.next, &storage, std::memory_order_release, std::memory_order_relaxed) ) {}
+            return &storage;
+        }();
+        return *record;
+    }
+
+    template<fp_operator op, std::floating_point T, qty_dimensions_type dimensions>
+    UT_UNITS_CRITICAL_INLINE constexpr void fp_check( qty<T,dimensions> result ) noexcept
+    {
+        if ( std::is_constant_evaluated() )
+            return;
+
+        switch ( std::fpclassify(result.value) )
+        {
+        case FP_SUBNORMAL: fp_record_for<dimensions,op>().denormal.fetch_add(1, std::memory_order_relaxed); break;
+        case FP_NAN:       fp_record_for<dimensions,op>().nan.fetch_add(1, std::memory_order_relaxed); break;
+        case FP_INFINITE:  fp_record_for<dimensions,op>().inf.fetch_add(1, std::memory_order_relaxed); break;
+        default: break;
+        }
+    }
+
+    template<std::floating_point T, qty_dimensions_type dimensions>
+    UT_UNITS_CRITICAL_INLINE constexpr void fp_check_divisor( qty<T,dimensions> result, T divisor ) noexcept
+    {
+        if ( std::is_constant_evaluated() )
+            return;
+
+        if ( divisor == T(0) )
+            fp_record_for<dimensions,fp_operator::divide>().divide_by_zero.fetch_add(1, std::memory_order_relaxed);
+
+        fp_check<fp_operator::divide>(result);
+    }
+} // end namespace ut::detail
+
+namespace ut
+{
+    // Returns the hazard counts of results with the given dimensions produced by op.
+    template<detail::qty_dimensions_type dimensions>
+    [[nodiscard]] inline fp_hazard_counts fp_hazards( fp_operator op ) noexcept
+    {
+        const auto snapshot = []( const detail::fp_record& record ) {
+            return fp_hazard_counts{
+                .denormal = record.denormal.load(std::memory_order_relaxed),
+                .nan = record.nan.load(std::memory_order_relaxed),
+                .inf = record.inf.load(std::memory_order_relaxed),
+                .divide_by_zero = record.divide_by_zero.load(std::memory_order_relaxed)
+            };
+        };
+
+        switch ( op )
+        {
+        case fp_operator::add:      return snapshot(detail::fp_record_for<dimensions,fp_operator::add>());
+        case fp_operator::subtract: return snapshot(detail::fp_record_for<dimensions,fp_operator::subtract>());
+        case fp_operator::multiply: return snapshot(detail::fp_record_for<dimensions,fp_operator::multiply>());
+        case fp_operator::divide:   return snapshot(detail::fp_record_for<dimensions,fp_operator::divide>());
+        }
+        return {};
+    }
+
+    // Zeroes every counter, records stay registered.
+    inline void fp_hazard_reset() noexcept
+    {
+        for ( detail::fp_record* record = detail::fp_records.load(std::memory_order_acquire); record; record = record->next )
+        {
+            record->denormal.store(0, std::memory_order_relaxed);
+            record->nan.store(0, std::memory_order_relaxed);
+            record->inf.store(0, std::memory_order_relaxed);
+            record->divide_by_zero.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Writes a table of every dimension/operator pair with at least one hazard.
+    inline void fp_hazard_report( std::FILE* file = stderr )
+    {
+        static constexpr const char* symbols[7] = { "s", "m", "kg", "A", "K", "mol", "cd" };
+        static constexpr char operators[4] = { '+', '-', '*', '/' };
+
+        std::fprintf(file, "%-32s %2s %12s %12s %12s %12s\n", "dimensions", "op", "denormal", "nan", "inf", "div0");
+        for ( detail::fp_record* record = detail::fp_records.load(std::memory_order_acquire); record; record = record->next )
+        {
+            const unsigned long long denormal = record->denormal.load(std::memory_order_relaxed);
+            const unsigned long long nan = record->nan.load(std::memory_order_relaxed);
+            const unsigned long long inf = record->inf.load(std::memory_order_relaxed);
+            const unsigned long long divide_by_zero = record->divide_by_zero.load(std::memory_order_relaxed);
+            if ( denormal == 0 && nan == 0 && inf == 0 && divide_by_zero == 0 )
+                continue;
+
+            char name[64] = "1";
+            int length = 0;
+            for ( int i = 0; i < 7; i++ )
+            {
+                if ( record->dimensions[i] == 0 )
+                    continue;
+                length += std::snprintf(name + length, sizeof(name) - length, "%s%s^%d", length ? " " : "", symbols[i], record->dimensions[i]);
+            }
+
+            std::fprintf(file, "%-32s %2c %12llu %12llu %12llu %12llu\n", name, operators[static_cast<int>(record->op)], denormal, nan, inf, divide_by_zero);
+        }
+    }
+} // end namespace ut
+#endif
+
 namespace ut // operators, unit definitions and aliases
 {
+    // Operators taking two quantities accept different scalar types, the
+    // result has the common (wider) scalar type. Narrowing back to a storage
+    // type is explicit with .cast<>().
+
     template<
-        std::floating_point T,
+        std::floating_point TLeft,
+        std::floating_point TRight,
         detail::qty_dimensions_type TyLeft,
-        detail::qty_dimensions_type TyRight
+        detail::qty_dimensions_type TyRight,
+        typename T = std::common_type_t<TLeft,TRight>
     >
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_multiply<T, TyLeft, TyRight>
-    operator*(qty<T,TyLeft> left, qty<T,TyRight> right) noexcept
+    operator*(qty<TLeft,TyLeft> left, qty<TRight,TyRight> right) noexcept
     {
         detail::qty_multiply<T, TyLeft,TyRight> value;
-        value.value = left.value * right.value;
+        value.value = T(left.value) * T(right.value);
+        UT_UNITS_FP_CHECK(fp_operator::multiply, value);
         return value;
     }
 
     template<
-        std::floating_point T,
+        std::floating_point TLeft,
+        std::floating_point TRight,
         detail::qty_dimensions_type TyLeft,
-        detail::qty_dimensions_type TyRight
+        detail::qty_dimensions_type TyRight,
+        typename T = std::common_type_t<TLeft,TRight>
     >
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_divide<T, TyLeft, TyRight>
-    operator/( qty<T,TyLeft> left, qty<T,TyRight> right) noexcept
+    operator/( qty<TLeft,TyLeft> left, qty<TRight,TyRight> right) noexcept
     {
         detail::qty_divide<T, TyLeft,TyRight> value;
-        value.value = left.value / right.value;
+        value.value = T(left.value) / T(right.value);
+        UT_UNITS_FP_CHECK_DIVISOR(value, T(right.value));
         return value;
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr TyLeft operator+(TyLeft left, TyRight right) noexcept
+    requires( detail::mixed_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<detail::common_scalar<TyLeft,TyRight>, typename TyLeft::dimensions> operator+(TyLeft left, TyRight right) noexcept
     {
-        TyLeft value;
-        value.value = left.value + right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        qty<T, typename TyLeft::dimensions> value;
+        value.value = T(left.value) + T(right.value);
+        UT_UNITS_FP_CHECK(fp_operator::add, value);
         return value;
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr TyLeft operator-(TyLeft left, TyRight right) noexcept
+    requires( detail::mixed_qty<TyLeft,TyRight> )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<detail::common_scalar<TyLeft,TyRight>, typename TyLeft::dimensions> operator-(TyLeft left, TyRight right) noexcept
     {
-        TyLeft value;
-        value.value = left.value - right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        qty<T, typename TyLeft::dimensions> value;
+        value.value = T(left.value) - T(right.value);
+        UT_UNITS_FP_CHECK(fp_operator::subtract, value);
         return value;
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     UT_UNITS_CRITICAL_INLINE constexpr void operator+=(TyLeft& left, TyRight right) noexcept
     {
+        static_assert( std::same_as<detail::common_scalar<TyLeft,TyRight>, typename TyLeft::type>,
+            "compound assignment would narrow the scalar type, use .cast<Scalar>() on the right hand side" );
         left.value += right.value;
+        UT_UNITS_FP_CHECK(fp_operator::add, left);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     UT_UNITS_CRITICAL_INLINE constexpr void operator-=(TyLeft& left, TyRight right) noexcept
     {
+        static_assert( std::same_as<detail::common_scalar<TyLeft,TyRight>, typename TyLeft::type>,
+            "compound assignment would narrow the scalar type, use .cast<Scalar>() on the right hand side" );
         left.value -= right.value;
+        UT_UNITS_FP_CHECK(fp_operator::subtract, left);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator<(TyLeft left, TyRight right) noexcept
     {
-        return left.value < right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) < T(right.value);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator<=(TyLeft left, TyRight right) noexcept
     {
-        return left.value <= right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) <= T(right.value);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator>(TyLeft left, TyRight right) noexcept
     {
-        return left.value > right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) > T(right.value);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator>=(TyLeft left, TyRight right) noexcept
     {
-        return left.value >= right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) >= T(right.value);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator==(TyLeft left, TyRight right) noexcept
     {
-        return left.value == right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) == T(right.value);
     }
 
     template<typename TyLeft, typename TyRight>
-    requires( detail::compatible_qty<TyLeft,TyRight> )
+    requires( detail::mixed_qty<TyLeft,TyRight> )
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr bool operator!=(TyLeft left, TyRight right) noexcept
     {
-        return left.value != right.value;
+        using T = detail::common_scalar<TyLeft,TyRight>;
+        return T(left.value) != T(right.value);
     }
 
     template<std::floating_point T, detail::qty_dimensions_type dimensions>
@@ -421,50 +692,58 @@ namespace ut // operators, unit definitions and aliases
     template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
     [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator*(Ty left, qty<T,dimensions> right) noexcept
     {
-        right.value *= left;
+        right.value *= T(left);
+        UT_UNITS_FP_CHECK(fp_operator::multiply, right);
         return right;
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator*(qty<T,dimensions> left, T right) noexcept
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator*(qty<T,dimensions> left, Ty right) noexcept
     {
-        left.value *= right;
+        left.value *= T(right);
+        UT_UNITS_FP_CHECK(fp_operator::multiply, left);
         return left;
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_divide<T, qty_dimensions<>, dimensions> operator/(T left, qty<T,dimensions> right) noexcept
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_divide<T, qty_dimensions<>, dimensions> operator/(Ty left, qty<T,dimensions> right) noexcept
     {
         detail::qty_divide<T, qty_dimensions<>, dimensions> result;
-        result.value = left / right.value;
+        result.value = T(left) / right.value;
+        UT_UNITS_FP_CHECK_DIVISOR(result, right.value);
         return result;
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator/(qty<T,dimensions> left, T right) noexcept
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator/(qty<T,dimensions> left, Ty right) noexcept
     {
-        left.value /= right;
+        left.value /= T(right);
+        UT_UNITS_FP_CHECK_DIVISOR(left, T(right));
         return left;
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator*(T left, qty_offset<T,dimensions> right) noexcept
+    // The result has the scalar type of the offset unit, as with operator* for qty
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> operator*(Ty left, qty_offset<T,dimensions> right) noexcept
     {
         qty<T,dimensions> result;
-        result.value = (left + right.offset) * right.value;
+        result.value = (T(left) + right.offset) * right.value;
+        UT_UNITS_FP_CHECK(fp_operator::multiply, result);
         return result;
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    UT_UNITS_CRITICAL_INLINE constexpr void operator*=(qty<T,dimensions>& left, T right) noexcept
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    UT_UNITS_CRITICAL_INLINE constexpr void operator*=(qty<T,dimensions>& left, Ty right) noexcept
     {
-        left.value *= right;
+        left.value *= T(right);
+        UT_UNITS_FP_CHECK(fp_operator::multiply, left);
     }
 
-    template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    UT_UNITS_CRITICAL_INLINE constexpr void operator/=(qty<T,dimensions>& left, T right) noexcept
+    template<std::floating_point T, detail::qty_dimensions_type dimensions, std::convertible_to<T> Ty>
+    UT_UNITS_CRITICAL_INLINE constexpr void operator/=(qty<T,dimensions>& left, Ty right) noexcept
     {
-        left.value /= right;
+        left.value /= T(right);
+        UT_UNITS_FP_CHECK_DIVISOR(left, T(right));
     }
 
     // SI units
@@ -642,6 +921,122 @@ namespace sym
     static constexpr auto pph       = ut::pound_per_hour;
 }
 
+namespace ut::detail // constant evaluation versions of <cmath> functions
+{
+    template<std::floating_point T>
+    [[nodiscard]] constexpr bool constexpr_signbit( T value ) noexcept
+    {
+        if constexpr ( sizeof(T) == sizeof(std::uint64_t) )
+            return ( std::bit_cast<std::uint64_t>(value) >> 63 ) != 0;
+        else if constexpr ( sizeof(T) == sizeof(std::uint32_t) )
+            return ( std::bit_cast<std::uint32_t>(value) >> 31 ) != 0;
+        else
+            return value < T(0); // no portable bit layout, -0.0 is treated as positive
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] constexpr T constexpr_abs( T value ) noexcept
+    {
+        return constexpr_signbit(value) ? -value : value;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] constexpr T constexpr_copysign( T number, T sign ) noexcept
+    {
+        return constexpr_signbit(number) == constexpr_signbit(sign) ? number : -number;
+    }
+
+    // Positive real D-th root of value by Newton-Raphson, within 1 ulp of
+    // the correctly rounded result. Only intended for constant evaluation.
+    template<int D, std::floating_point T>
+    [[nodiscard]] constexpr T constexpr_root( T value ) noexcept
+    {
+        static_assert( D > 0, "root must be positive" );
+        if constexpr ( D == 1 )
+            return value;
+
+        if ( value != value || value == T(0) || value == std::numeric_limits<T>::infinity() )
+            return value;
+
+        if ( value < T(0) )
+        {
+            if constexpr ( D % 2 == 1 )
+                return -constexpr_root<D>( -value );
+            else
+                return std::numeric_limits<T>::quiet_NaN();
+        }
+
+        // value = m * 2^e with m in [1,2), so 2^(floor(e/D)+1) is above the
+        // root by at most a factor of two and the iteration decreases monotonically
+        int exponent = 0;
+        for ( T mantissa = value; mantissa >= T(2); mantissa /= T(2) )
+            exponent++;
+        for ( T mantissa = value; mantissa < T(1); mantissa *= T(2) )
+            exponent--;
+
+        const int guess_exponent = ( exponent >= 0 ? exponent / D : -( ( D - 1 - exponent ) / D ) ) + 1;
+        T current = T(1);
+        for ( int i = 0; i < guess_exponent; i++ )
+            current *= T(2);
+        for ( int i = 0; i > guess_exponent; i-- )
+            current /= T(2);
+
+        T previous = T(0);
+        T before_previous = T(0);
+        for ( int i = 0; i < 4096 && current != previous && current != before_previous; i++ )
+        {
+            before_previous = previous;
+            previous = current;
+
+            T power = T(1);
+            for ( int j = 0; j < D - 1; j++ )
+                power *= current;
+
+            current = ( T(D - 1) * current + value / power ) / T(D);
+        }
+        return current;
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T sqrt( T value ) noexcept
+    {
+        if ( std::is_constant_evaluated() )
+            return constexpr_root<2>(value);
+        return std::sqrt(value);
+    }
+
+    template<int D, std::floating_point T>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T root( T value ) noexcept
+    {
+        if ( std::is_constant_evaluated() )
+            return constexpr_root<D>(value);
+
+        if constexpr ( D == 1 )
+            return value;
+        else if constexpr ( D == 2 )
+            return std::sqrt(value);
+        else if constexpr ( D == 3 )
+            return std::cbrt(value);
+        else if constexpr ( D % 2 == 1 )
+            return value < T(0) ? -std::pow(-value, T(1) / T(D)) : std::pow(value, T(1) / T(D));
+        else
+            return std::pow(value, T(1) / T(D));
+    }
+
+    [[nodiscard]] consteval int gcd( int a, int b ) noexcept
+    {
+        a = a < 0 ? -a : a;
+        b = b < 0 ? -b : b;
+        while ( b != 0 )
+        {
+            const int remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+        return a;
+    }
+} // end namespace ut::detail
+
 // functions
 namespace ut
 {
@@ -667,11 +1062,12 @@ namespace ut
     // template<std::floating_point T, typename dimensions>
     // UT_UNITS_CRITICAL_INLINE constexpr qty<T,dimensions> create( T value )
 
+    // Constant evaluation uses Newton-Raphson (within 1 ulp), otherwise std::sqrt
     template<std::floating_point T, detail::qty_dimensions_type dimensions>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE detail::qty_sqrt<T,dimensions> sqrt( qty<T,dimensions> value )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_sqrt<T,dimensions> sqrt( qty<T,dimensions> value ) noexcept
     {
         detail::qty_sqrt<T,dimensions> result;
-        result.value = std::sqrt(value.value);
+        result.value = detail::sqrt(value.value);
         return result;
     }
 
@@ -692,7 +1088,7 @@ namespace ut
         {
             detail::qty_pow<N,T,dimensions> result;
             result.value = 1.0;
-            for ( int i = 0; i < std::abs(N); i++ )
+            for ( int i = 0; i < -N; i++ )
             {
                 result.value /= value.value;
             }
@@ -700,19 +1096,40 @@ namespace ut
         }
     }
 
+    // Raises to the rational power N/D, e.g. pow<3,2>( area ) is a volume.
+    // Every dimension multiplied by N must be divisible by D.
+    template<int N, int D, std::floating_point T, detail::qty_dimensions_type dimensions>
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr detail::qty_rational_pow<N,D,T,dimensions> pow( qty<T,dimensions> value ) noexcept
+    {
+        constexpr int sign = D < 0 ? -1 : 1;
+        constexpr int numerator = sign * N / detail::gcd(N, D);
+        constexpr int denominator = sign * D / detail::gcd(N, D);
+
+        qty<T,dimensions> root;
+        root.value = detail::root<denominator>(value.value);
+
+        detail::qty_rational_pow<N,D,T,dimensions> result;
+        result.value = pow<numerator>(root).value;
+        return result;
+    }
+
     template<typename T>
-    [[nodiscard]] UT_UNITS_CRITICAL_INLINE T abs( T value )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr T abs( T value ) noexcept
     {
-        const auto new_value = std::abs(scalar(value));
-        assign(value, new_value);
+        if ( std::is_constant_evaluated() )
+            assign(value, detail::constexpr_abs(scalar(value)));
+        else
+            assign(value, std::abs(scalar(value)));
         return value;
     }
  
     template<typename TyNumber, typename TySign>
-    UT_UNITS_CRITICAL_INLINE TyNumber copysign( TyNumber number, TySign sign )
+    [[nodiscard]] UT_UNITS_CRITICAL_INLINE constexpr TyNumber copysign( TyNumber number, TySign sign ) noexcept
     {
-        const auto new_value = std::copysign(scalar(number), scalar(sign));
-        assign(number, new_value);
+        if ( std::is_constant_evaluated() )
+            assign(number, detail::constexpr_copysign(scalar(number), decltype(scalar(number))(scalar(sign))));
+        else
+            assign(number, std::copysign(scalar(number), decltype(scalar(number))(scalar(sign))));
         return number;
     }
-}
\ No newline at end of file
+}
@@ -194,6 +194,123 @@ TEST_CASE("Operations", "[Functions]")
         static constexpr ut::area<double> area = ut::pow<2>( length );
         const ut::length<double> length_again = ut::sqrt( area );
         REQUIRE( length.value == length_again.value );
+
+        static constexpr ut::length<double> constexpr_length = ut::sqrt( area );
+        REQUIRE_THAT( constexpr_length.value, Catch::Matchers::WithinULP(length.value, 1) );
+
+        for ( const double value : { 2.0, 1e-300, 0.3, 123456789.0, 1e300 } )
+        {
+            const ut::length<double> expected = ut::sqrt( value * ut::metre2 );
+            REQUIRE_THAT( ut::detail::constexpr_root<2>( value ), Catch::Matchers::WithinULP(expected.value, 1) );
+        }
+        static_assert( ut::detail::constexpr_root<2>( 0.0 ) == 0.0 );
+        static_assert( ut::detail::constexpr_root<2>( -1.0 ) != ut::detail::constexpr_root<2>( -1.0 ) );
+    }
+
+    SECTION("rational pow")
+    {
+        static constexpr ut::area<double> area = 4.0 * ut::metre2;
+        static constexpr ut::volume<double> volume = ut::pow<3,2>( area );
+        static_assert( std::same_as<decltype(ut::pow<1,3>( volume )), ut::length<double>> );
+        static_assert( std::same_as<decltype(ut::pow<-1,2>( area )), decltype(1.0 / ut::metre)> );
+
+        REQUIRE_THAT( volume.in(ut::metre3), Catch::Matchers::WithinULP(8.0, 1) );
+        REQUIRE_THAT( (ut::pow<1,3>( volume ).in(ut::metre)), Catch::Matchers::WithinULP(2.0, 1) );
+        REQUIRE_THAT( (ut::pow<2,4>( area ).in(ut::metre)), Catch::Matchers::WithinULP(2.0, 1) );
+
+        static constexpr ut::length<double> cube_root = ut::pow<1,3>( -27.0 * ut::metre3 );
+        REQUIRE_THAT( cube_root.in(ut::metre), Catch::Matchers::WithinULP(-3.0, 1) );
+
+        // extreme magnitudes must not overflow while converging
+        static constexpr double seventh_root_large = ut::detail::constexpr_root<7>( 1e300 );
+        static constexpr double seventh_root_small = ut::detail::constexpr_root<7>( 1e-300 );
+        static constexpr ut::length<double> cube_root_large = ut::pow<1,3>( 1e300 * ut::metre3 );
+        static constexpr ut::length<double> cube_root_small = ut::pow<1,3>( 1e-300 * ut::metre3 );
+        REQUIRE_THAT( std::pow(seventh_root_large, 7.0), Catch::Matchers::WithinRel(1e300, 1e-14) );
+        REQUIRE_THAT( std::pow(seventh_root_small, 7.0), Catch::Matchers::WithinRel(1e-300, 1e-14) );
+        REQUIRE_THAT( cube_root_large.value, Catch::Matchers::WithinULP(1e100, 1) );
+        REQUIRE_THAT( cube_root_small.value, Catch::Matchers::WithinULP(1e-100, 1) );
+    }
+
+    SECTION("abs and copysign")
+    {
+        static constexpr ut::length<double> length = ut::abs( -3.0 * ut::metre );
+        static constexpr double negative_zero = ut::copysign( 0.0, -1.0 );
+        static constexpr ut::speed<double> speed = ut::copysign( 2.0 * ut::metre_per_second, -0.0 * ut::metre );
+
+        REQUIRE( length.value == 3.0 );
+        REQUIRE( std::signbit( negative_zero ) );
+        REQUIRE( speed.value == -2.0 );
+
+        // the sign may have a different scalar type than the number
+        static constexpr ut::length<double> mixed = ut::copysign( 2.0 * ut::metre, -1.0f );
+        REQUIRE( mixed.value == -2.0 );
+        REQUIRE( ut::copysign( 2.0 * ut::metre, 1.0f ).value == 2.0 );
+        REQUIRE( ut::copysign( ut::length<float>{ 2.0f }, -1.0 * ut::second ).value == -2.0f );
+        REQUIRE( !std::signbit( ut::abs( -0.0 ) ) );
+        static_assert( !ut::detail::constexpr_signbit( ut::abs( -0.0 ) ) );
+    }
+}
+
+TEST_CASE("Mixed precision", "[Functions][Mixed]")
+{
+    // float storage, double constants
+    ut::length<float> position = ( 1000.0 * ut::foot ).cast<float>();
+    const ut::speed<double> velocity = 250.0 * ut::knot;
+    const ut::time<double> dt = 0.01 * ut::second;
+
+    SECTION("Promotion")
+    {
+        const auto next = position + velocity * dt;
+        static_assert( std::same_as<decltype(next), const ut::length<double>> );
+        static_assert( std::same_as<decltype(position * position), ut::area<float>> );
+        static_assert( std::same_as<decltype(position / dt), ut::speed<double>> );
+        static_assert( std::same_as<decltype(position - position), ut::length<float>> );
+
+        REQUIRE_THAT( next.in(ut::foot), Catch::Matchers::WithinRel(1000.0 + 250.0 * 1852.0 / 3600.0 * 0.01 / 0.3048, 1e-7) );
+
+        // explicit narrowing back to storage
+        position = next.cast<float>();
+        position += ( velocity * dt ).cast<float>();
+        REQUIRE_THAT( position.in(ut::foot), Catch::Matchers::WithinRel(float(1000.0 + 2.0 * 250.0 * 1852.0 / 3600.0 * 0.01 / 0.3048), 1e-6f) );
+
+        // scalars of either type on either side keep the quantity's scalar type
+        static_assert( std::same_as<decltype(position * 2.0), ut::length<float>> );
+        static_assert( std::same_as<decltype(2.0 * position), ut::length<float>> );
+        static_assert( std::same_as<decltype(position / 2.0), ut::length<float>> );
+        static_assert( std::same_as<decltype(2.0 / position), ut::qty<float,ut::qty_dimensions<0,-1>>> );
+        const ut::length<float> doubled = position * 2.0;
+        REQUIRE( doubled.value == 2.0f * position.value );
+        REQUIRE( (0.5 * doubled).value == position.value );
+        REQUIRE( (doubled / 2.0).value == position.value );
+        REQUIRE( (1.0 / ut::length<float>{ 4.0f }).value == 0.25f );
+        ut::length<float> scaled = position;
+        scaled *= 2.0;
+        scaled /= 4.0;
+        REQUIRE( scaled.value == 0.5f * position.value );
+
+        // widening compound assignment is implicit
+        ut::length<double> total = 0.0 * ut::metre;
+        total += position;
+        REQUIRE( total.value == double( position.value ) );
+    }
+
+    SECTION("Comparison and in")
+    {
+        const ut::length<float> one_foot = ( 1.0 * ut::foot ).cast<float>();
+        REQUIRE_FALSE( (one_foot == 1.0f * ut::foot) ); // 0.3048 is not exact in float
+        REQUIRE( (one_foot < 0.31 * ut::metre) );
+        REQUIRE( (one_foot > 0.30 * ut::metre) );
+        REQUIRE( (one_foot != 1.0 * ut::metre) );
+
+        static_assert( std::same_as<decltype(one_foot.in(ut::foot)), float> );
+        REQUIRE_THAT( one_foot.in(ut::foot), Catch::Matchers::WithinULP(1.0f, 1) );
+        REQUIRE_THAT( one_foot.in(ut::inch), Catch::Matchers::WithinULP(12.0f, 1) );
+
+        const ut::temperature<float> oat = ( 15.0f * ut::celsius ).cast<float>();
+        static_assert( std::same_as<decltype(15.0f * ut::celsius), ut::temperature<double>> );
+        REQUIRE_THAT( oat.in(ut::celsius), Catch::Matchers::WithinAbs(15.0f, 1e-5f) );
+        REQUIRE_THAT( oat.in(ut::fahrenheit), Catch::Matchers::WithinAbs(59.0f, 1e-4f) );
     }
 }
 
@@ -0,0 +1,137 @@
+#include <ut-units-angle.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Angles", "[Angle]")
+{
+    constexpr double pi = std::numbers::pi;
+
+    SECTION("Wrapping")
+    {
+        REQUIRE_THAT( ut::wrap_pi( 1.5 * pi * ut::radian ).in(ut::radian), WithinAbs(-0.5 * pi, 1e-15) );
+        REQUIRE_THAT( ut::wrap_pi( 270.0 * ut::degree ).in(ut::degree), WithinAbs(-90.0, 1e-12) );
+        REQUIRE_THAT( ut::wrap_pi( -3.25 * ut::revolution ).in(ut::degree), WithinAbs(-90.0, 1e-12) );
+        REQUIRE( ut::wrap_pi( pi * ut::radian ).value == pi );
+        REQUIRE( ut::wrap_pi( -pi * ut::radian ).value == pi );
+
+        REQUIRE_THAT( ut::wrap_2pi( -0.5 * pi * ut::radian ).in(ut::radian), WithinAbs(1.5 * pi, 1e-15) );
+        REQUIRE( ut::wrap_2pi( 2.0 * pi * ut::radian ).value == 0.0 );
+        const ut::angle<double> tiny = ut::wrap_2pi( -1.0e-20 * ut::radian );
+        REQUIRE( tiny.value >= 0.0 );
+        REQUIRE( tiny.value < 2.0 * pi );
+
+        REQUIRE_THAT( ut::angular_difference( 10.0 * ut::degree, 350.0 * ut::degree ).in(ut::degree), WithinAbs(20.0, 1e-12) );
+        REQUIRE_THAT( ut::angular_difference( 350.0 * ut::degree, 10.0 * ut::degree ).in(ut::degree), WithinAbs(-20.0, 1e-12) );
+
+        // large angles keep full precision
+        for ( const double value : { 1.0e6, -7.5e7, 123456.789 } )
+        {
+            const long double exact = std::remainder( static_cast<long double>( value ), 2.0l * std::numbers::pi_v<long double> );
+            REQUIRE_THAT( ut::wrap_pi( value * ut::radian ).value, WithinAbs(static_cast<double>( exact ), 1e-11) );
+        }
+
+        // split constants do not depend on the width of long double
+        static_assert( ut::detail::two_pi<double>::value == 2.0 * std::numbers::pi );
+        static_assert( ut::detail::two_pi<double>::head + ut::detail::two_pi<double>::middle + ut::detail::two_pi<double>::tail == 2.0 * std::numbers::pi );
+        static_assert( ut::detail::two_pi<float>::value == 2.0f * std::numbers::pi_v<float> );
+        static_assert( ut::detail::two_pi<float>::rounding == float( 2.0 * std::numbers::pi - double( ut::detail::two_pi<float>::value ) ) );
+
+        const ut::angle<float> wrapped = ut::wrap_pi( ut::angle<float>{ 7.0f } );
+        REQUIRE_THAT( wrapped.value, WithinAbs(7.0f - 2.0f * std::numbers::pi_v<float>, 1e-6f) );
+    }
+
+    SECTION("Batch wrapping")
+    {
+        std::vector<ut::angle<double>> angles;
+        for ( int i = -500; i < 500; i++ )
+            angles.push_back( ( 0.37 * i ) * ut::radian );
+        std::vector<ut::angle<double>> wrapped( angles.size() );
+        std::vector<ut::angle<double>> wrapped2( angles.size() );
+        std::vector<ut::angle<double>> difference( angles.size() );
+
+        ut::wrap_pi<double>( angles, wrapped );
+        ut::wrap_2pi<double>( angles, wrapped2 );
+        ut::angular_difference<double>( angles, wrapped2, difference );
+        for ( std::size_t i = 0; i < angles.size(); i++ )
+        {
+            REQUIRE( wrapped[i].value == ut::wrap_pi( angles[i] ).value );
+            REQUIRE( wrapped2[i].value == ut::wrap_2pi( angles[i] ).value );
+            REQUIRE( wrapped[i].value > -pi );
+            REQUIRE( wrapped[i].value <= pi );
+            REQUIRE( wrapped2[i].value >= 0.0 );
+            REQUIRE( wrapped2[i].value < 2.0 * pi );
+            REQUIRE_THAT( difference[i].value, WithinAbs(0.0, 1e-12) );
+        }
+    }
+
+    SECTION("Unwrapping")
+    {
+        // chirp, phase = 0.5 t + 0.01 t^2
+        const std::size_t count = 2000;
+        std::vector<ut::angle<double>> phase( count );
+        std::vector<ut::angle<double>> wrapped( count );
+        for ( std::size_t i = 0; i < count; i++ )
+        {
+            const double t = 0.1 * i;
+            phase[i] = ( 0.5 * t + 0.01 * t * t ) * ut::radian;
+            wrapped[i] = ut::wrap_pi( phase[i] );
+        }
+
+        ut::phase_unwrapper<double> scalar;
+        ut::phase_unwrapper<double> batch;
+        std::vector<ut::angle<double>> unwrapped( count );
+        const std::span<const ut::angle<double>> in( wrapped );
+        const std::span<ut::angle<double>> out( unwrapped );
+        batch( in.subspan( 0, 7 ), out.subspan( 0, 7 ) );
+        batch( in.subspan( 7, 600 ), out.subspan( 7, 600 ) );
+        batch( in.subspan( 607 ), out.subspan( 607 ) );
+
+        for ( std::size_t i = 0; i < count; i++ )
+        {
+            const ut::angle<double> single = scalar( wrapped[i] );
+            REQUIRE_THAT( single.value, WithinAbs(phase[i].value, 1e-9) );
+            REQUIRE( unwrapped[i].value == single.value );
+        }
+        REQUIRE( batch.turns == scalar.turns );
+        REQUIRE( batch.turns > 30.0 );
+    }
+
+    SECTION("Rate integration")
+    {
+        // 1e6 steps of a 50 Hz rotation in single precision
+        const ut::angular_rate<float> rate = ( 2.0f * std::numbers::pi_v<float> * 50.0f ) * ut::radian_per_second.cast<float>();
+        const ut::time<float> dt = 1.0e-4f * ut::second.cast<float>();
+        const std::size_t steps = 1000000;
+        const long double increment = static_cast<long double>( rate.value * dt.value );
+
+        ut::phase_integrator<float> integrator;
+        for ( std::size_t i = 0; i < steps / 2; i++ )
+            (void)integrator.advance( rate, dt );
+
+        const std::vector<ut::angular_rate<float>> rates( steps / 2, rate );
+        std::vector<ut::angle<float>> phases( steps / 2 );
+        integrator.advance( rates, dt, phases );
+
+        const long double total = increment * steps;
+        const long double exact = std::remainder( total, 2.0l * std::numbers::pi_v<long double> );
+        REQUIRE_THAT( integrator.phase.value, WithinAbs(static_cast<float>( exact ), 2e-6f) );
+        REQUIRE( phases.back().value == integrator.phase.value );
+        REQUIRE( integrator.turns == std::nearbyint( static_cast<double>( ( total - exact ) / ( 2.0l * std::numbers::pi_v<long double> ) ) ) );
+
+        // naive single precision accumulation drifts far more
+        float naive = 0.0f;
+        for ( std::size_t i = 0; i < steps; i++ )
+            naive = std::remainder( naive + rate.value * dt.value, 2.0f * std::numbers::pi_v<float> );
+        REQUIRE( std::abs( naive - static_cast<float>( exact ) ) > 1e-4f );
+
+        integrator.reset( 5.0 * ut::revolution.cast<float>() + ut::angle<float>{ 0.25f } );
+        REQUIRE_THAT( integrator.phase.value, WithinAbs(0.25f, 1e-5f) );
+        REQUIRE( integrator.turns == 5.0f );
+    }
+}
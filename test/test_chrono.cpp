@@ -0,0 +1,86 @@
+#include <ut-units-chrono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+using Catch::Matchers::WithinULP;
+
+TEST_CASE("Chrono Conversions", "[Chrono]")
+{
+    SECTION("from_chrono")
+    {
+        static constexpr ut::time<double> ms = ut::from_chrono<double>( std::chrono::milliseconds(1500) );
+        static constexpr ut::time<double> min = ut::from_chrono<double>( std::chrono::minutes(2) );
+        static constexpr ut::time<float> h = ut::from_chrono<float>( std::chrono::duration<double,std::ratio<3600>>(0.5) );
+
+        REQUIRE_THAT( ms.in(ut::second), WithinULP(1.5, 1) );
+        REQUIRE( min.in(ut::minute) == 2.0 );
+        REQUIRE( h.value == 1800.0f );
+    }
+
+    SECTION("to_chrono")
+    {
+        static constexpr auto ns = ut::to_chrono<std::chrono::nanoseconds>( 1.5 * ut::second );
+        static_assert( ns.count() == 1'500'000'000 );
+
+        // integral ticks round to nearest, halves away from zero
+        static_assert( ut::to_chrono<std::chrono::seconds>( 1.9 * ut::second ).count() == 2 );
+        static_assert( ut::to_chrono<std::chrono::seconds>( 1.4 * ut::second ).count() == 1 );
+        static_assert( ut::to_chrono<std::chrono::seconds>( 2.5 * ut::second ).count() == 3 );
+        static_assert( ut::to_chrono<std::chrono::seconds>( -1.9 * ut::second ).count() == -2 );
+        static_assert( ut::to_chrono<std::chrono::seconds>( -0.4 * ut::second ).count() == 0 );
+
+        const auto ms = ut::to_chrono<std::chrono::duration<double,std::milli>>( 0.25 * ut::minute );
+        REQUIRE( ms.count() == 15000.0 );
+    }
+
+    SECTION("round trip")
+    {
+        const std::chrono::nanoseconds ns( 123'456'789 );
+        REQUIRE( ut::to_chrono<std::chrono::nanoseconds>( ut::from_chrono<double>(ns) ) == ns );
+
+        static_assert( ut::to_chrono<std::chrono::microseconds>( ut::from_chrono<double>( std::chrono::microseconds(15) ) ).count() == 15 );
+
+        std::size_t mismatches = 0;
+        for ( std::int64_t count = -1'000'000; count <= 1'000'000; count++ )
+        {
+            const std::chrono::microseconds us( count );
+            const std::chrono::milliseconds ms( count );
+            mismatches += ut::to_chrono<std::chrono::microseconds>( ut::from_chrono<double>(us) ) != us;
+            mismatches += ut::to_chrono<std::chrono::milliseconds>( ut::from_chrono<double>(ms) ) != ms;
+            mismatches += ut::to_chrono<std::chrono::microseconds>( ut::from_chrono<double>(ms) ) != ms;
+        }
+        REQUIRE( mismatches == 0 );
+
+        // float round trips while the two roundings stay below half a tick
+        for ( std::int32_t count = 0; count < ( 1 << 21 ); count += 97 )
+        {
+            const std::chrono::milliseconds ms( count );
+            mismatches += ut::to_chrono<std::chrono::milliseconds>( ut::from_chrono<float>(ms) ) != ms;
+        }
+        REQUIRE( mismatches == 0 );
+    }
+
+    SECTION("frequency")
+    {
+        static constexpr ut::frequency<double> f = ut::frequency_from_chrono<double>( std::chrono::milliseconds(20) );
+        REQUIRE_THAT( f.in(ut::hertz), WithinULP(50.0, 1) );
+
+        static constexpr auto period = ut::to_chrono<std::chrono::microseconds>( 400.0 * ut::hertz );
+        static_assert( period.count() == 2500 );
+    }
+}
+
+TEST_CASE("Scoped Timer", "[Chrono]")
+{
+    ut::time<double> latency = 0.0 * ut::second;
+    {
+        ut::scoped_timer timer( latency );
+        std::this_thread::sleep_for( std::chrono::milliseconds(2) );
+        REQUIRE( timer.elapsed().in(ut::second) > 0.0 );
+    }
+    REQUIRE( latency.in(ut::second) >= 2.0e-3 );
+}
@@ -0,0 +1,105 @@
+#include <ut-units-codec.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Channel Codec", "[Codec]")
+{
+    // slowly varying altitude channel with some repeated samples
+    std::vector<ut::length<double>> altitudes;
+    for ( int i = 0; i < 5000; i++ )
+        altitudes.push_back( ( 10000.0 + 500.0 * std::sin( i * 0.001 ) + ( i % 7 == 0 ? 0.0 : 0.25 * ( i % 3 ) ) ) * ut::foot );
+
+    SECTION("Lossless")
+    {
+        std::vector<std::uint8_t> stream;
+        ut::encode_channel<ut::length<double>>( altitudes, stream );
+
+        ut::channel_header header;
+        REQUIRE( ut::read_channel_header( stream, header ) == ut::codec_status::ok );
+        REQUIRE( header.mode == ut::codec_mode::xor_float );
+        REQUIRE( header.count == altitudes.size() );
+        REQUIRE( header.dimensions == std::array<std::int8_t,7>{ 0, 1, 0, 0, 0, 0, 0 } );
+        REQUIRE( header.payload_bytes + ut::channel_header::size == stream.size() );
+
+        std::vector<ut::length<double>> decoded( altitudes.size() );
+        std::size_t count = 0;
+        REQUIRE( ut::decode_channel<ut::length<double>>( stream, decoded, count ) == ut::codec_status::ok );
+        REQUIRE( count == altitudes.size() );
+        for ( std::size_t i = 0; i < count; i++ )
+            REQUIRE( std::bit_cast<std::uint64_t>( decoded[i].value ) == std::bit_cast<std::uint64_t>( altitudes[i].value ) );
+    }
+
+    SECTION("Lossless special values")
+    {
+        const std::vector<ut::speed<float>> speeds = {
+            ut::speed<float>{ 0.0f }, ut::speed<float>{ -0.0f }, ut::speed<float>{ 1.0f }, ut::speed<float>{ 1.0f },
+            ut::speed<float>{ std::numeric_limits<float>::infinity() }, ut::speed<float>{ std::numeric_limits<float>::denorm_min() },
+            ut::speed<float>{ -3.5e30f }, ut::speed<float>{ 2.0f } };
+
+        std::vector<std::uint8_t> stream;
+        ut::encode_channel<ut::speed<float>>( speeds, stream );
+
+        std::vector<ut::speed<float>> decoded( speeds.size() );
+        std::size_t count = 0;
+        REQUIRE( ut::decode_channel<ut::speed<float>>( stream, decoded, count ) == ut::codec_status::ok );
+        for ( std::size_t i = 0; i < speeds.size(); i++ )
+            REQUIRE( std::bit_cast<std::uint32_t>( decoded[i].value ) == std::bit_cast<std::uint32_t>( speeds[i].value ) );
+    }
+
+    SECTION("Quantized")
+    {
+        const ut::length<double> resolution = 0.01 * ut::foot;
+        std::vector<std::uint8_t> stream;
+        ut::encode_channel<ut::length<double>>( altitudes, resolution, stream );
+
+        std::vector<std::uint8_t> lossless;
+        ut::encode_channel<ut::length<double>>( altitudes, lossless );
+        REQUIRE( stream.size() * 3 < lossless.size() );
+        REQUIRE( stream.size() < altitudes.size() * 2 );
+
+        std::vector<ut::length<double>> decoded( altitudes.size() );
+        std::size_t count = 0;
+        REQUIRE( ut::decode_channel<ut::length<double>>( stream, decoded, count ) == ut::codec_status::ok );
+        for ( std::size_t i = 0; i < count; i++ )
+            REQUIRE_THAT( decoded[i].in(ut::foot), WithinAbs(altitudes[i].in(ut::foot), 0.005 + 1e-9) );
+
+        // a double resolution quantizes a float channel
+        std::vector<ut::length<float>> float_altitudes( altitudes.size() );
+        for ( std::size_t i = 0; i < altitudes.size(); i++ )
+            float_altitudes[i] = altitudes[i].cast<float>();
+        std::vector<std::uint8_t> float_stream;
+        ut::encode_channel<ut::length<float>>( float_altitudes, 0.01 * ut::foot, float_stream );
+
+        std::vector<ut::length<float>> float_decoded( altitudes.size() );
+        REQUIRE( ut::decode_channel<ut::length<float>>( float_stream, float_decoded, count ) == ut::codec_status::ok );
+        REQUIRE( count == altitudes.size() );
+        for ( std::size_t i = 0; i < count; i++ )
+            REQUIRE_THAT( float_decoded[i].in(ut::foot), WithinAbs(float_altitudes[i].in(ut::foot), 0.005 + 1e-3) );
+    }
+
+    SECTION("Errors")
+    {
+        std::vector<std::uint8_t> stream;
+        ut::encode_channel<ut::length<double>>( altitudes, stream );
+
+        std::vector<ut::time<double>> times( altitudes.size() );
+        std::vector<ut::length<float>> floats( altitudes.size() );
+        std::vector<ut::length<double>> small( 10 );
+        std::vector<ut::length<double>> decoded( altitudes.size() );
+        std::size_t count = 0;
+
+        REQUIRE( ut::decode_channel<ut::time<double>>( stream, times, count ) == ut::codec_status::dimension_mismatch );
+        REQUIRE( ut::decode_channel<ut::length<float>>( stream, floats, count ) == ut::codec_status::type_mismatch );
+        REQUIRE( ut::decode_channel<ut::length<double>>( stream, small, count ) == ut::codec_status::too_small );
+        REQUIRE( ut::decode_channel<ut::length<double>>( std::span( stream ).first( stream.size() - 1 ), decoded, count ) == ut::codec_status::truncated );
+
+        stream[0] = 'X';
+        REQUIRE( ut::decode_channel<ut::length<double>>( stream, decoded, count ) == ut::codec_status::bad_header );
+    }
+}
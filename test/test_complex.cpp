@@ -0,0 +1,125 @@
+#include <ut-units-complex.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Complex Quantities", "[Complex]")
+{
+    // series RC at 50 Hz
+    const ut::angular_rate<double> omega = 2.0 * std::numbers::pi * 50.0 * ut::radian_per_second;
+    const ut::qty resistance = 100.0 * ut::ohm;
+    const ut::qty capacitance = 10.0e-6 * ut::farad;
+    const ut::impedance<double> z{ resistance, -1.0 / ( omega * capacitance ) };
+    const double reactance = 1.0 / ( 2.0 * std::numbers::pi * 50.0 * 10.0e-6 );
+
+    SECTION("Types")
+    {
+        static_assert( !ut::detail::qty_type<ut::impedance<double>> );
+        static_assert( std::same_as<decltype(ut::abs(z)), ut::qty<double,decltype(ut::ohm)::dimensions>> );
+        static_assert( std::same_as<decltype(ut::arg(z)), ut::angle<double>> );
+
+        const ut::phasor_current<double> i{ 2.0 * ut::ampere, 0.0 * ut::ampere };
+        static_assert( std::same_as<decltype(i * z), ut::phasor_voltage<double>> );
+        static_assert( std::same_as<decltype(i * z * ut::conj(i)), ut::complex_power<double>> );
+        static_assert( std::same_as<decltype(1.0 / z), ut::admittance<double>> );
+        static_assert( std::same_as<decltype(ut::complex_qty{ 1.0 * ut::metre, 2.0 * ut::metre }), ut::complex_qty<double,ut::qty_dimensions<0,1>>> );
+    }
+
+    SECTION("Scalar arithmetic")
+    {
+        REQUIRE_THAT( ut::abs(z).in(ut::ohm), WithinRel(std::hypot(100.0, reactance), 1e-12) );
+        REQUIRE_THAT( ut::arg(z).in(ut::radian), WithinRel(std::atan2(-reactance, 100.0), 1e-12) );
+
+        const ut::phasor_voltage<double> v = ut::polar( 230.0 * ut::volt, 0.0 * ut::radian );
+        const ut::phasor_current<double> i = v / z;
+        const ut::complex_power<double> s = v * ut::conj(i);
+
+        // current leads the voltage across a capacitive load
+        REQUIRE( ut::arg(i).value > 0.0 );
+        REQUIRE_THAT( ut::abs(i).in(ut::ampere), WithinRel(230.0 / ut::abs(z).in(ut::ohm), 1e-12) );
+        // real power dissipated in R, reactive power negative
+        REQUIRE_THAT( s.real.in(ut::watt), WithinRel(ut::abs(i).in(ut::ampere) * ut::abs(i).in(ut::ampere) * 100.0, 1e-12) );
+        REQUIRE( s.imag.value < 0.0 );
+
+        const ut::phasor_voltage<double> round_trip = i * z;
+        REQUIRE_THAT( round_trip.real.in(ut::volt), WithinRel(230.0, 1e-12) );
+        REQUIRE_THAT( round_trip.imag.in(ut::volt), WithinAbs(0.0, 1e-12) );
+
+        const ut::impedance<double> doubled = z + z;
+        REQUIRE( doubled == 2.0 * z );
+        REQUIRE( doubled == z * 2.0 );
+        REQUIRE( doubled / 2.0 == z );
+        REQUIRE( z * 2.0f == 2.0 * z );
+        REQUIRE( doubled - z == z );
+        REQUIRE( -z != z );
+
+        const std::complex<double> in_ohm = z.in( ut::ohm );
+        REQUIRE( in_ohm.real() == 100.0 );
+    }
+
+    SECTION("Split layout batch")
+    {
+        const std::size_t count = 515;
+        ut::complex_qty_vector<double,decltype(ut::volt)::dimensions> v;
+        ut::complex_qty_vector<double,decltype(ut::ohm)::dimensions> loads;
+        for ( std::size_t k = 0; k < count; k++ )
+        {
+            v.push_back( ut::polar( (230.0 + 0.01 * k) * ut::volt, (0.001 * k) * ut::radian ) );
+            loads.push_back( { (10.0 + k) * ut::ohm, (0.5 * k - 100.0) * ut::ohm } );
+        }
+
+        ut::complex_qty_vector<double,decltype(ut::ampere)::dimensions> i( count );
+        ut::complex_qty_vector<double,decltype(ut::watt)::dimensions> s( count );
+        ut::complex_qty_vector<double,decltype(ut::volt)::dimensions> v_check( count );
+        std::vector<ut::power<double>> apparent( count );
+        std::vector<ut::angle<double>> phase( count );
+
+        ut::divide( v.span(), loads.span(), i.span() );
+        ut::multiply_conj( v.span(), i.span(), s.span() );
+        ut::multiply( i.span(), loads.span(), v_check.span() );
+        ut::abs( s.span(), std::span(apparent) );
+        ut::arg( s.span(), std::span(phase) );
+
+        for ( std::size_t k = 0; k < count; k += 17 )
+        {
+            const ut::phasor_current<double> expected_i = v[k] / loads[k];
+            const ut::complex_power<double> expected_s = v[k] * ut::conj( expected_i );
+            REQUIRE_THAT( i[k].real.in(ut::ampere), WithinRel(expected_i.real.in(ut::ampere), 1e-12) );
+            REQUIRE_THAT( i[k].imag.in(ut::ampere), WithinRel(expected_i.imag.in(ut::ampere), 1e-12) );
+            REQUIRE_THAT( s[k].real.in(ut::watt), WithinRel(expected_s.real.in(ut::watt), 1e-12) );
+            REQUIRE_THAT( v_check[k].real.in(ut::volt), WithinRel(v[k].real.in(ut::volt), 1e-12) );
+            REQUIRE_THAT( apparent[k].in(ut::watt), WithinRel(ut::abs(expected_s).in(ut::watt), 1e-12) );
+            // power factor angle matches the load angle
+            REQUIRE_THAT( phase[k].in(ut::radian), WithinAbs(ut::arg(loads[k]).in(ut::radian), 1e-12) );
+        }
+
+        std::vector<ut::length<double>> magnitude( 3, 2.0 * ut::metre );
+        const std::vector<ut::angle<double>> angles{ 0.0 * ut::radian, 0.5 * std::numbers::pi * ut::radian, std::numbers::pi * ut::radian };
+        ut::complex_qty_vector<double,ut::qty_dimensions<0,1>> points( 3 );
+        ut::polar( std::span<const ut::length<double>>(magnitude), std::span(angles), points.span() );
+        REQUIRE_THAT( points[1].imag.in(ut::metre), WithinRel(2.0, 1e-12) );
+        REQUIRE_THAT( points[2].real.in(ut::metre), WithinRel(-2.0, 1e-12) );
+
+        // batch abs keeps the range of the scalar abs
+        ut::complex_qty_vector<double,ut::qty_dimensions<0,1>> extremes;
+        extremes.push_back( { 3.0e200 * ut::metre, 4.0e200 * ut::metre } );
+        extremes.push_back( { 3.0e-200 * ut::metre, -4.0e-200 * ut::metre } );
+        extremes.push_back( { 0.0 * ut::metre, 0.0 * ut::metre } );
+        extremes.push_back( { ut::length<double>{ -std::numeric_limits<double>::infinity() }, 1.0 * ut::metre } );
+        std::vector<ut::length<double>> extreme_magnitude( extremes.size() );
+        ut::abs( extremes.span(), std::span(extreme_magnitude) );
+        for ( std::size_t k = 0; k < 3; k++ )
+            REQUIRE_THAT( extreme_magnitude[k].value, WithinRel(ut::abs(extremes[k]).value, 1e-15) );
+        REQUIRE( extreme_magnitude[3].value == std::numeric_limits<double>::infinity() );
+
+        ut::complex_qty_vector<double,ut::qty_dimensions<0,1>> sum( 3 );
+        ut::add( points.span(), points.span(), sum.span() );
+        REQUIRE_THAT( sum[2].real.in(ut::metre), WithinRel(-4.0, 1e-12) );
+    }
+}
@@ -0,0 +1,159 @@
+#include <ut-units-csv.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("CSV Reader", "[CSV]")
+{
+    const std::string text =
+        "time_s, alt_ft, oat_degC, ias_kt, flight_phase, mach\r\n"
+        "0.0, 1000, 15.0, 120, 1, 0.18\r\n"
+        "0.5, +1010.5, -2.5e1, 121, 1, 0.181\r\n"
+        "\r\n"
+        "1.0, 1021, , 122, 2, 0.182\r\n";
+
+    SECTION("Header units")
+    {
+        std::istringstream input( text );
+        ut::csv_reader reader( input );
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+        REQUIRE( reader.fields.size() == 6 );
+        REQUIRE( reader.fields[1].name == "alt" );
+        REQUIRE( reader.fields[1].unit.symbol == "ft" );
+        REQUIRE( reader.fields[2].unit.offset == 273.15 );
+        // no known suffix, the whole text is the name
+        REQUIRE( reader.fields[4].name == "flight_phase" );
+        REQUIRE( reader.fields[5].unit.scale == 1.0 );
+    }
+
+    SECTION("Typed columns")
+    {
+        std::istringstream input( text );
+        ut::csv_reader reader( input );
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+
+        std::vector<ut::time<double>> time;
+        std::vector<ut::length<double>> altitude;
+        std::vector<ut::temperature<float>> oat;
+        std::vector<ut::speed<double>> ias;
+        std::vector<ut::qty<double>> mach;
+        REQUIRE( reader.bind( "time", time ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "alt_ft", altitude ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "oat", oat ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "ias", ias ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "mach", mach ) == ut::csv_status::ok );
+
+        std::vector<ut::time<double>> wrong;
+        REQUIRE( reader.bind( "alt", wrong ) == ut::csv_status::dimension_mismatch );
+        REQUIRE( reader.bind( "tas", wrong ) == ut::csv_status::unknown_column );
+
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE( reader.rows == 3 );
+        REQUIRE( altitude.size() == 3 );
+        REQUIRE( oat.size() == 3 );
+
+        REQUIRE_THAT( time[1].in(ut::second), WithinRel(0.5) );
+        REQUIRE_THAT( altitude[1].in(ut::metre), WithinRel(1010.5 * 0.3048, 1e-12) );
+        REQUIRE_THAT( oat[0].value, WithinRel(288.15f, 1e-6f) );
+        REQUIRE_THAT( oat[1].value, WithinRel(248.15f, 1e-6f) );
+        REQUIRE( std::isnan( oat[2].value ) );
+        REQUIRE_THAT( ias[2].in(ut::knot), WithinRel(122.0, 1e-12) );
+        REQUIRE_THAT( mach[2].value, WithinRel(0.182) );
+    }
+
+    SECTION("Incremental and small chunks")
+    {
+        std::string large = "t_s;h_m\n";
+        for ( int i = 0; i < 1000; i++ )
+            large += std::to_string( i ) + ";" + std::to_string( 0.25 * i ) + "\n";
+        large += "1000;250"; // no final newline
+
+        std::istringstream input( large );
+        ut::csv_reader reader( input, ';' );
+        reader.chunk_size = 7;
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+
+        std::vector<ut::length<double>> height;
+        REQUIRE( reader.bind( "h", height ) == ut::csv_status::ok );
+
+        REQUIRE( reader.read( 300 ) == ut::csv_status::ok );
+        REQUIRE( height.size() == 300 );
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE( height.size() == 1001 );
+        for ( std::size_t i = 0; i < height.size(); i++ )
+            REQUIRE( height[i].value == 0.25 * i );
+    }
+
+    SECTION("Growing stream")
+    {
+        std::stringstream input;
+        input << "t_s,h_m\n0,1\n1,2\n";
+        ut::csv_reader reader( input );
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+
+        std::vector<ut::length<double>> height;
+        REQUIRE( reader.bind( "h", height ) == ut::csv_status::ok );
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE( height.size() == 2 );
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE( height.size() == 2 );
+
+        // the writer appends after the reader reached the end
+        input.clear();
+        input << "2,3\n3,4\n";
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE( height.size() == 4 );
+        REQUIRE( height[3].value == 4.0 );
+        REQUIRE( reader.rows == 4 );
+    }
+
+    SECTION("Custom units")
+    {
+        std::istringstream input( "depth_fathom,temp_degR\n2,491.67\n" );
+        ut::csv_reader reader( input );
+        reader.add_unit( "fathom", 6.0 * ut::foot );
+        reader.add_unit( "degR", ut::qty_offset<double,ut::qty_dimensions<0,0,0,0,1>>{ .value = 5.0 / 9.0, .offset = 0.0 } );
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+
+        std::vector<ut::length<double>> depth;
+        std::vector<ut::temperature<double>> temperature;
+        REQUIRE( reader.bind( "depth", depth ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "temp", temperature ) == ut::csv_status::ok );
+        REQUIRE( reader.read() == ut::csv_status::ok );
+        REQUIRE_THAT( depth[0].in(ut::foot), WithinRel(12.0, 1e-12) );
+        REQUIRE_THAT( temperature[0].in(ut::celsius), WithinAbs(0.0, 1e-9) );
+    }
+
+    SECTION("Errors")
+    {
+        std::istringstream empty( "" );
+        ut::csv_reader empty_reader( empty );
+        REQUIRE( empty_reader.read_header() == ut::csv_status::bad_header );
+
+        std::istringstream input( "a_m,b_m\n1,2\n3,x\n5,6\n7\n" );
+        ut::csv_reader reader( input );
+        REQUIRE( reader.read_header() == ut::csv_status::ok );
+        std::vector<ut::length<double>> a;
+        std::vector<ut::length<double>> b;
+        REQUIRE( reader.bind( "a", a ) == ut::csv_status::ok );
+        REQUIRE( reader.bind( "b", b ) == ut::csv_status::ok );
+
+        REQUIRE( reader.read() == ut::csv_status::bad_number );
+        REQUIRE( reader.line == 3 );
+        // the bad row is dropped so the columns stay aligned
+        REQUIRE( a.size() == 1 );
+        REQUIRE( b.size() == 1 );
+
+        REQUIRE( reader.read() == ut::csv_status::missing_field );
+        REQUIRE( reader.line == 5 );
+        REQUIRE( a.size() == 2 );
+        REQUIRE( b.size() == 2 );
+    }
+}
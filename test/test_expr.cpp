@@ -0,0 +1,66 @@
+#include <ut-units-expr.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <array>
+#include <utility>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Expression Templates", "[Expression]")
+{
+    std::vector<ut::mass<double>> m;
+    std::vector<ut::speed<double>> v;
+    std::vector<ut::length<double>> h;
+    for ( int i = 0; i < 37; i++ )
+    {
+        m.push_back( (1.0 + i) * ut::kilogram );
+        v.push_back( (2.0 * i) * ut::metre_per_second );
+        h.push_back( (100.0 - i) * ut::foot );
+    }
+
+    const ut::acceleration<double> g = 9.80665 * ut::metre_per_second2;
+
+    SECTION("Fused evaluation")
+    {
+        std::vector<ut::energy<double>> e( m.size() );
+        ut::lazy(e) = 0.5 * ut::lazy(m) * ut::lazy(v) * ut::lazy(v) + ut::lazy(m) * g * ut::lazy(h);
+
+        for ( std::size_t i = 0; i < e.size(); i++ )
+        {
+            const ut::energy<double> expected = 0.5 * m[i] * v[i] * v[i] + m[i] * g * h[i];
+            REQUIRE_THAT( e[i].in(ut::joule), WithinRel(expected.in(ut::joule)) );
+        }
+    }
+
+    SECTION("Result types")
+    {
+        const auto kinetic = 0.5 * ut::lazy(m) * ut::lazy(v) * ut::lazy(v);
+        static_assert( std::same_as<decltype(kinetic)::value_type, ut::energy<double>> );
+
+        const auto rate = ut::lazy(v) / ut::lazy(h);
+        static_assert( std::same_as<decltype(rate)::value_type, ut::frequency<double>> );
+    }
+
+    SECTION("Compound assignment and negation")
+    {
+        std::array<ut::length<double>, 37> position{};
+        const ut::time<double> dt = 0.1 * ut::second;
+
+        ut::lazy(position) += ut::lazy(v) * dt;
+        ut::lazy(position) -= -ut::lazy(h);
+
+        for ( std::size_t i = 0; i < position.size(); i++ )
+            REQUIRE_THAT( position[i].in(ut::metre), WithinRel((v[i] * dt + h[i]).in(ut::metre)) );
+    }
+
+    SECTION("Lazy span copy")
+    {
+        std::vector<ut::length<double>> copy( h.size() );
+        auto target = ut::lazy(copy);
+        target = ut::lazy(std::as_const(h));
+        REQUIRE( copy[10].value == h[10].value );
+        REQUIRE( target.values.data() == copy.data() );
+    }
+}
@@ -0,0 +1,126 @@
+#include <ut-units-filter.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    // steady state amplitude of a sine through the filter
+    template<typename Filter>
+    double sine_gain( Filter filter, ut::frequency<double> frequency, ut::time<double> dt )
+    {
+        double peak = 0.0;
+        for ( int i = 0; i < 20000; i++ )
+        {
+            const ut::length<double> output = filter( std::sin( 2.0 * std::numbers::pi * ( frequency * ( i * dt ) ) ) * ut::metre );
+            if ( i > 10000 )
+                peak = std::max( peak, std::abs( output.in(ut::metre) ) );
+        }
+        return peak;
+    }
+}
+
+TEST_CASE("Filters", "[Filter]")
+{
+    const ut::time<double> dt = 1.0e-3 * ut::second;
+
+    SECTION("Cutoff units")
+    {
+        const ut::frequency<double> cutoff = ut::cycles_per_second( 2.0 * std::numbers::pi * ut::radian_per_second );
+        REQUIRE_THAT( cutoff.in(ut::hertz), WithinRel(1.0, 1e-15) );
+    }
+
+    SECTION("Low pass")
+    {
+        ut::low_pass_filter<ut::temperature<double>> filter{ ut::design_low_pass( 1.0 * ut::hertz, dt ) };
+        filter.reset( 10.0 * ut::celsius );
+
+        // step response after one time constant, 1 / (2 pi) s
+        ut::temperature<double> output;
+        const int steps = int( std::round( 1.0 / ( 2.0 * std::numbers::pi ) / dt.in(ut::second) ) );
+        for ( int i = 0; i < steps; i++ )
+            output = filter( 20.0 * ut::celsius );
+        const double expected = 20.0 - 10.0 * std::exp( -steps * dt.in(ut::second) * 2.0 * std::numbers::pi );
+        REQUIRE_THAT( output.in(ut::celsius), WithinRel(expected, 1e-9) );
+    }
+
+    SECTION("Complementary")
+    {
+        // gyro with a bias, accelerometer with noise free angle
+        ut::complementary_filter<ut::angle<double>> filter{ ut::design_complementary( 0.5 * ut::hertz, dt ) };
+        static_assert( std::same_as<ut::complementary_filter<ut::angle<double>>::rate_type, ut::angular_rate<double>> );
+
+        const ut::angular_rate<double> bias = 0.01 * ut::radian_per_second;
+        ut::angle<double> angle;
+        for ( int i = 0; i < 20000; i++ )
+            angle = filter( bias, 0.3 * ut::radian );
+
+        // steady state error is bias * dt * alpha / (1 - alpha), about bias / (2 pi fc)
+        const double alpha = filter.coefficients.alpha;
+        REQUIRE_THAT( angle.in(ut::radian), WithinRel(0.3 + 0.01 * 1.0e-3 * alpha / ( 1.0 - alpha ), 1e-9) );
+    }
+
+    SECTION("Biquad")
+    {
+        const ut::biquad_coefficients<double> low_pass = ut::design_biquad_low_pass( 10.0 * ut::hertz, dt );
+        REQUIRE_THAT( sine_gain( ut::biquad_filter<ut::length<double>>{ low_pass }, 1.0 * ut::hertz, dt ), WithinAbs(1.0, 1e-3) );
+        REQUIRE_THAT( sine_gain( ut::biquad_filter<ut::length<double>>{ low_pass }, 10.0 * ut::hertz, dt ), WithinAbs(std::sqrt(0.5), 1e-3) );
+        REQUIRE( sine_gain( ut::biquad_filter<ut::length<double>>{ low_pass }, 100.0 * ut::hertz, dt ) < 0.011 );
+
+        const ut::biquad_coefficients<double> high_pass = ut::design_biquad_high_pass( 10.0 * ut::hertz, dt );
+        REQUIRE_THAT( sine_gain( ut::biquad_filter<ut::length<double>>{ high_pass }, 10.0 * ut::hertz, dt ), WithinAbs(std::sqrt(0.5), 1e-3) );
+
+        const ut::biquad_coefficients<double> band_pass = ut::design_biquad_band_pass( 50.0 * ut::hertz, dt, 5.0 );
+        REQUIRE_THAT( sine_gain( ut::biquad_filter<ut::length<double>>{ band_pass }, 50.0 * ut::hertz, dt ), WithinAbs(1.0, 1e-3) );
+
+        const ut::biquad_coefficients<double> notch = ut::design_biquad_notch( 50.0 * ut::hertz, dt, 5.0 );
+        REQUIRE( sine_gain( ut::biquad_filter<ut::length<double>>{ notch }, 50.0 * ut::hertz, dt ) < 1e-3 );
+
+        ut::biquad_filter<ut::length<double>> settled{ low_pass };
+        settled.reset( 3.0 * ut::metre );
+        REQUIRE_THAT( settled( 3.0 * ut::metre ).in(ut::metre), WithinRel(3.0, 1e-12) );
+    }
+
+    SECTION("Banks")
+    {
+        const std::size_t channels = 37;
+        ut::low_pass_bank<ut::pressure<double>> low_pass_bank;
+        ut::biquad_bank<ut::pressure<double>> biquad_bank;
+        std::vector<ut::low_pass_filter<ut::pressure<double>>> low_pass_filters;
+        std::vector<ut::biquad_filter<ut::pressure<double>>> biquad_filters;
+        for ( std::size_t c = 0; c < channels; c++ )
+        {
+            const ut::frequency<double> cutoff = ( 1.0 + c ) * ut::hertz;
+            low_pass_filters.push_back( { ut::design_low_pass( cutoff, dt ) } );
+            biquad_filters.push_back( { ut::design_biquad_low_pass( cutoff, dt ) } );
+            REQUIRE( low_pass_bank.add_channel( low_pass_filters.back().coefficients ) == c );
+            REQUIRE( biquad_bank.add_channel( biquad_filters.back().coefficients ) == c );
+        }
+
+        std::vector<ut::pressure<double>> input( channels );
+        std::vector<ut::pressure<double>> low_pass_output( channels );
+        std::vector<ut::pressure<double>> biquad_output( channels );
+        // the bank may contract to fused multiply adds differently to the scalar filters
+        const auto close = []( ut::pressure<double> a, ut::pressure<double> b ) { return std::abs( a.value - b.value ) <= 1e-9 * std::abs( b.value ); };
+        bool same = true;
+        for ( int step = 0; step < 500; step++ )
+        {
+            for ( std::size_t c = 0; c < channels; c++ )
+                input[c] = ( 1000.0 + 10.0 * std::sin( 0.01 * step * c ) ) * ut::millibar;
+
+            low_pass_bank.process( input, low_pass_output );
+            biquad_bank.process( input, biquad_output );
+            for ( std::size_t c = 0; c < channels; c++ )
+            {
+                same &= close( low_pass_output[c], low_pass_filters[c]( input[c] ) );
+                same &= close( biquad_output[c], biquad_filters[c]( input[c] ) );
+            }
+        }
+        REQUIRE( same );
+    }
+}
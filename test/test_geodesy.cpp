@@ -0,0 +1,100 @@
+#include <ut-units-geodesy.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    ut::geo::position<double> degrees( double latitude, double longitude )
+    {
+        return { latitude * ut::degree, longitude * ut::degree };
+    }
+
+    double dms( double d, double m, double s )
+    {
+        return d < 0 ? d - m / 60.0 - s / 3600.0 : d + m / 60.0 + s / 3600.0;
+    }
+}
+
+TEST_CASE("Geodesy", "[Geodesy]")
+{
+    const ut::geo::position<double> jfk = degrees( 40.6398, -73.7789 );
+    const ut::geo::position<double> lhr = degrees( 51.4700, -0.4543 );
+
+    SECTION("Haversine and bearing")
+    {
+        REQUIRE_THAT( ut::geo::haversine_distance( jfk, lhr ).in(ut::metre), WithinRel(5540175.856, 1e-9) );
+        REQUIRE_THAT( ut::geo::haversine_distance( jfk, lhr ).in(ut::nautical_mile), WithinRel(2991.4556, 1e-7) );
+        REQUIRE_THAT( ut::geo::initial_bearing( jfk, lhr ).in(ut::degree), WithinAbs(51.351331, 1e-6) );
+
+        REQUIRE_THAT( ut::geo::initial_bearing( degrees( 0, 0 ), degrees( 0, 10 ) ).in(ut::degree), WithinAbs(90.0, 1e-9) );
+        REQUIRE_THAT( ut::geo::initial_bearing( degrees( 0, 0 ), degrees( 0, -10 ) ).in(ut::degree), WithinAbs(270.0, 1e-9) );
+        REQUIRE_THAT( ut::geo::initial_bearing( degrees( 10, 0 ), degrees( 0, 0 ) ).in(ut::degree), WithinAbs(180.0, 1e-9) );
+    }
+
+    SECTION("Destination")
+    {
+        const ut::geo::position<double> end = ut::geo::destination( jfk, ut::geo::initial_bearing( jfk, lhr ), ut::geo::haversine_distance( jfk, lhr ) );
+        REQUIRE_THAT( end.latitude.in(ut::degree), WithinAbs(51.4700, 1e-9) );
+        REQUIRE_THAT( end.longitude.in(ut::degree), WithinAbs(-0.4543, 1e-9) );
+
+        // one degree of longitude along the equator, across the antimeridian
+        const ut::geo::position<double> east = ut::geo::destination( degrees( 0, 179.5 ), 90.0 * ut::degree, ut::geo::mean_radius * ( std::numbers::pi / 180.0 ) );
+        REQUIRE_THAT( east.latitude.in(ut::degree), WithinAbs(0.0, 1e-9) );
+        REQUIRE_THAT( east.longitude.in(ut::degree), WithinAbs(-179.5, 1e-9) );
+
+        const ut::geo::position<double> north = ut::geo::destination( degrees( 0, 0 ), 0.0 * ut::degree, 60.0 * ut::nautical_mile );
+        REQUIRE_THAT( north.latitude.in(ut::degree), WithinAbs(1.0, 0.01) );
+    }
+
+    SECTION("Vincenty")
+    {
+        // Flinders Peak to Buninyong, Vincenty (1975)
+        const ut::geo::position<double> flinders = degrees( dms( -37, 57, 3.72030 ), dms( 144, 25, 29.52440 ) );
+        const ut::geo::position<double> buninyong = degrees( dms( -37, 39, 10.15610 ), dms( 143, 55, 35.38390 ) );
+        REQUIRE_THAT( ut::geo::vincenty_distance( flinders, buninyong ).in(ut::metre), WithinAbs(54972.271, 0.001) );
+
+        REQUIRE( ut::geo::vincenty_distance( jfk, jfk ).value == 0.0 );
+
+        // a quarter of the equator
+        REQUIRE_THAT( ut::geo::vincenty_distance( degrees( 0, 0 ), degrees( 0, 90 ) ).in(ut::metre),
+            WithinRel(ut::geo::wgs84_semi_major_axis.in(ut::metre) * std::numbers::pi / 2.0, 1e-12) );
+
+        // pole to pole, half a meridian
+        REQUIRE_THAT( ut::geo::vincenty_distance( degrees( 90, 0 ), degrees( -90, 0 ) ).in(ut::metre), WithinAbs(20003931.4586, 0.001) );
+    }
+
+    SECTION("Batch")
+    {
+        std::vector<ut::geo::position<double>> from;
+        std::vector<ut::geo::position<double>> to;
+        for ( int i = 0; i < 100; i++ )
+        {
+            from.push_back( degrees( -80.0 + 1.6 * i, -170.0 + 3.4 * i ) );
+            to.push_back( degrees( 60.0 - 1.1 * i, 20.0 + 1.5 * i ) );
+        }
+
+        std::vector<ut::length<double>> distance( from.size() );
+        std::vector<ut::length<double>> ellipsoidal( from.size() );
+        std::vector<ut::angle<double>> bearing( from.size() );
+        std::vector<ut::geo::position<double>> end( from.size() );
+        ut::geo::haversine_distance<double>( from, to, distance );
+        ut::geo::vincenty_distance<double>( from, to, ellipsoidal );
+        ut::geo::initial_bearing<double>( from, to, bearing );
+        ut::geo::destination<double>( from, bearing, distance, end );
+
+        for ( std::size_t i = 0; i < from.size(); i++ )
+        {
+            REQUIRE( distance[i].value == ut::geo::haversine_distance( from[i], to[i] ).value );
+            REQUIRE( ellipsoidal[i].value == ut::geo::vincenty_distance( from[i], to[i] ).value );
+            REQUIRE_THAT( ellipsoidal[i].in(ut::metre), WithinRel(distance[i].in(ut::metre), 0.006) );
+            REQUIRE( bearing[i].value == ut::geo::initial_bearing( from[i], to[i] ).value );
+            REQUIRE_THAT( end[i].latitude.in(ut::degree), WithinAbs(to[i].latitude.in(ut::degree), 1e-8) );
+            REQUIRE_THAT( end[i].longitude.in(ut::degree), WithinAbs(to[i].longitude.in(ut::degree), 1e-8) );
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include <ut-units.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+
+#ifdef UT_UNITS_FP_INSTRUMENTATION
+
+TEST_CASE("Floating Point Instrumentation", "[Instrumentation]")
+{
+    using length_dims = decltype(ut::metre)::dimensions;
+    using speed_dims = decltype(ut::metre_per_second)::dimensions;
+    using frequency_dims = decltype(ut::hertz)::dimensions;
+
+    ut::fp_hazard_reset();
+
+    SECTION("Divide by zero")
+    {
+        volatile double zero = 0.0;
+        const ut::speed<double> speed = (1.0 * ut::metre) / (zero * ut::second);
+        REQUIRE( speed.value == std::numeric_limits<double>::infinity() );
+
+        const ut::fp_hazard_counts counts = ut::fp_hazards<speed_dims>(ut::fp_operator::divide);
+        REQUIRE( counts.divide_by_zero == 1 );
+        REQUIRE( counts.inf == 1 );
+        REQUIRE( counts.nan == 0 );
+
+        const ut::frequency<double> frequency = 1.0 / (zero * ut::second);
+        REQUIRE( ut::fp_hazards<frequency_dims>(ut::fp_operator::divide).divide_by_zero == 1 );
+        (void)frequency;
+    }
+
+    SECTION("NaN and denormal")
+    {
+        volatile double tiny = std::numeric_limits<double>::min();
+        ut::length<double> length = tiny * ut::metre;
+        length *= 0.5;
+        REQUIRE( ut::fp_hazards<length_dims>(ut::fp_operator::multiply).denormal == 1 );
+
+        const ut::length<double> infinite = std::numeric_limits<double>::infinity() * ut::metre;
+        const ut::length<double> nan = infinite - infinite;
+        REQUIRE( std::isnan(nan.value) );
+        REQUIRE( ut::fp_hazards<length_dims>(ut::fp_operator::multiply).inf == 1 );
+        REQUIRE( ut::fp_hazards<length_dims>(ut::fp_operator::subtract).nan == 1 );
+        REQUIRE( ut::fp_hazards<length_dims>(ut::fp_operator::add).nan == 0 );
+    }
+
+    SECTION("Normal results are not counted")
+    {
+        const ut::speed<double> speed = (10.0 * ut::metre) / (2.0 * ut::second);
+        const ut::speed<double> sum = speed + speed;
+        REQUIRE( sum.value == 10.0 );
+
+        const ut::fp_hazard_counts counts = ut::fp_hazards<speed_dims>(ut::fp_operator::divide);
+        REQUIRE( counts.denormal == 0 );
+        REQUIRE( counts.nan == 0 );
+        REQUIRE( counts.inf == 0 );
+        REQUIRE( counts.divide_by_zero == 0 );
+    }
+
+    SECTION("Mixed precision")
+    {
+        volatile float zero = 0.0f;
+        const ut::speed<double> speed = (1.0 * ut::metre) / ut::time<float>{ zero };
+        REQUIRE( speed.value == std::numeric_limits<double>::infinity() );
+        REQUIRE( ut::fp_hazards<speed_dims>(ut::fp_operator::divide).divide_by_zero == 1 );
+
+        const ut::qty<double,ut::qty_dimensions<1,-1>> pace = ut::time<double>{ 2.0 } / ut::length<float>{ 4.0f };
+        REQUIRE( pace.value == 0.5 );
+
+        ut::length<float> length = ut::length<float>{ 1.0f } / 0.0;
+        length /= zero;
+        REQUIRE( ut::fp_hazards<length_dims>(ut::fp_operator::divide).divide_by_zero == 2 );
+    }
+
+    SECTION("Constant evaluation is unaffected")
+    {
+        static constexpr ut::speed<double> speed = (10.0 * ut::metre) / (2.0 * ut::second);
+        static_assert( speed.value == 5.0 );
+    }
+}
+
+#endif
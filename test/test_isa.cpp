@@ -0,0 +1,102 @@
+#include <ut-units-isa.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    struct table_row
+    {
+        double altitude;        // geopotential, m
+        double temperature;     // K
+        double pressure;        // Pa
+        double density;         // kg/m^3
+    };
+
+    // ICAO Doc 7488 standard atmosphere
+    constexpr table_row table[] = {
+        { -2000.0, 301.15, 127774.0, 1.47808 },
+        {     0.0, 288.15, 101325.0, 1.22500 },
+        {  1000.0, 281.65,  89874.6, 1.11164 },
+        {  5000.0, 255.65,  54019.9, 0.736116 },
+        { 11000.0, 216.65,  22632.0, 0.363918 },
+        { 15000.0, 216.65,  12044.6, 0.193674 },
+        { 20000.0, 216.65,  5474.88, 0.0880347 },
+        { 25000.0, 221.65,  2511.02, 0.0394657 },
+        { 40000.0, 251.05,  277.520, 0.00385099 },
+        { 60000.0, 245.45,  20.3141, 0.000288319 },
+        { 80000.0, 196.65, 0.886272, 0.0000157004 },
+    };
+}
+
+TEST_CASE("International Standard Atmosphere", "[ISA]")
+{
+    SECTION("Published table")
+    {
+        for ( const table_row& row : table )
+        {
+            const ut::isa::conditions<double> result = ut::isa::at( row.altitude * ut::metre );
+            REQUIRE_THAT( result.temperature.in(ut::kelvin), WithinAbs(row.temperature, 1e-9) );
+            REQUIRE_THAT( result.pressure.in(ut::pascal), WithinRel(row.pressure, 1e-5) );
+            REQUIRE_THAT( result.density.in(ut::kilogram_per_metre3), WithinRel(row.density, 1e-5) );
+            REQUIRE_THAT( ut::isa::temperature_at( row.altitude * ut::metre ).in(ut::kelvin), WithinAbs(row.temperature, 1e-9) );
+            REQUIRE_THAT( ut::isa::pressure_altitude( result.pressure ).in(ut::metre), WithinAbs(row.altitude, 1e-6) );
+        }
+
+        REQUIRE_THAT( ut::isa::sea_level_density.in(ut::kilogram_per_metre3), WithinRel(1.225, 1e-6) );
+        REQUIRE_THAT( ut::isa::pressure_at( 0.0 * ut::foot ).in(ut::inches_of_mercury), WithinRel(29.92, 1e-4) );
+        REQUIRE_THAT( ut::isa::pressure_altitude( 1013.25 * ut::millibar ).in(ut::foot), WithinAbs(0.0, 1e-9) );
+    }
+
+    SECTION("Geopotential altitude")
+    {
+        const ut::length<double> geometric = 10000.0 * ut::metre;
+        const ut::length<double> geopotential = ut::isa::geopotential_altitude( geometric );
+        REQUIRE_THAT( geopotential.in(ut::metre), WithinAbs(9984.3, 0.05) );
+        REQUIRE_THAT( ut::isa::geometric_altitude( geopotential ).in(ut::metre), WithinRel(10000.0, 1e-12) );
+    }
+
+    SECTION("Lower atmosphere fast path")
+    {
+        for ( double altitude = -5000.0; altitude <= 20000.0; altitude += 250.0 )
+        {
+            const ut::isa::conditions<double> layered = ut::isa::at( altitude * ut::metre );
+            const ut::isa::conditions<double> fast = ut::isa::lower_at( altitude * ut::metre );
+            REQUIRE_THAT( fast.temperature.in(ut::kelvin), WithinRel(layered.temperature.in(ut::kelvin), 1e-14) );
+            REQUIRE_THAT( fast.pressure.in(ut::pascal), WithinRel(layered.pressure.in(ut::pascal), 1e-13) );
+            REQUIRE_THAT( ut::isa::lower_pressure_altitude( fast.pressure ).in(ut::metre), WithinAbs(altitude, 1e-6) );
+        }
+
+        const ut::isa::conditions<float> single = ut::isa::lower_at( ut::length<float>{ 3000.0f } );
+        REQUIRE_THAT( single.pressure.value, WithinRel(70108.5f, 1e-5f) );
+    }
+
+    SECTION("Batch")
+    {
+        // one block entirely in the lower atmosphere, one spanning into the stratosphere
+        std::vector<ut::length<double>> altitudes;
+        for ( int i = 0; i < 600; i++ )
+            altitudes.push_back( ( i < 256 ? 50.0 * i : 150.0 * i ) * ut::foot );
+
+        std::vector<ut::temperature<double>> temperatures( altitudes.size() );
+        std::vector<ut::pressure<double>> pressures( altitudes.size() );
+        std::vector<ut::density<double>> densities( altitudes.size() );
+        ut::isa::at<double>( altitudes, temperatures, pressures, densities );
+
+        std::vector<ut::length<double>> inverted( altitudes.size() );
+        ut::isa::pressure_altitude<double>( pressures, inverted );
+
+        for ( std::size_t i = 0; i < altitudes.size(); i++ )
+        {
+            const ut::isa::conditions<double> expected = ut::isa::at( altitudes[i] );
+            REQUIRE_THAT( temperatures[i].in(ut::kelvin), WithinRel(expected.temperature.in(ut::kelvin), 1e-14) );
+            REQUIRE_THAT( pressures[i].in(ut::pascal), WithinRel(expected.pressure.in(ut::pascal), 1e-13) );
+            REQUIRE_THAT( densities[i].in(ut::kilogram_per_metre3), WithinRel(expected.density.in(ut::kilogram_per_metre3), 1e-13) );
+            REQUIRE_THAT( inverted[i].in(ut::foot), WithinAbs(altitudes[i].in(ut::foot), 1e-6) );
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include <ut-units-ode.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    using oscillator_state = std::tuple<ut::length<double>, ut::speed<double>>;
+
+    // x'' = -omega^2 x, x(0) = 1 m, v(0) = 0
+    constexpr ut::frequency<double> omega = 2.0 * ut::hertz;
+
+    ut::derivative_of<oscillator_state> oscillator( ut::time<double>, const oscillator_state& y )
+    {
+        return { std::get<1>(y), -(omega * omega) * std::get<0>(y) };
+    }
+}
+
+TEST_CASE("ODE Integrators", "[ODE]")
+{
+    static_assert( std::same_as<ut::derivative_of<ut::length<double>>, ut::speed<double>> );
+    static_assert( std::same_as<ut::derivative_of<oscillator_state>, std::tuple<ut::speed<double>, ut::acceleration<double>>> );
+    static_assert( std::same_as<ut::derivative_of<std::array<ut::speed<float>,3>>, std::array<ut::acceleration<float>,3>> );
+
+    const oscillator_state initial{ 1.0 * ut::metre, 0.0 * ut::metre_per_second };
+    const ut::time<double> end = 3.0 * ut::second;
+    const double expected_x = std::cos( (omega * end) );
+    const double expected_v = -std::sin( (omega * end) ) * omega.in(ut::hertz);
+
+    SECTION("rk4")
+    {
+        const ut::time<double> dt = 1.0e-3 * ut::second;
+        oscillator_state y = initial;
+        ut::time<double> t = 0.0 * ut::second;
+        for ( int i = 0; i < 3000; i++ )
+        {
+            y = ut::rk4_step( oscillator, t, y, dt );
+            t += dt;
+        }
+        REQUIRE_THAT( std::get<0>(y).in(ut::metre), WithinAbs(expected_x, 1e-10) );
+        REQUIRE_THAT( std::get<1>(y).in(ut::metre_per_second), WithinAbs(expected_v, 1e-10) );
+    }
+
+    SECTION("rk4 scalar state")
+    {
+        // dT/dt = -k (T - T_ambient)
+        const ut::frequency<double> k = 0.1 * ut::hertz;
+        const ut::temperature<double> ambient = 20.0 * ut::celsius;
+        const auto cooling = [&]( ut::time<double>, ut::temperature<double> temperature ) { return -k * (temperature - ambient); };
+
+        ut::temperature<double> temperature = 90.0 * ut::celsius;
+        for ( int i = 0; i < 100; i++ )
+            temperature = ut::rk4_step( cooling, 0.0 * ut::second, temperature, 0.1 * ut::second );
+
+        REQUIRE_THAT( temperature.in(ut::celsius), WithinRel(20.0 + 70.0 * std::exp(-1.0), 1e-9) );
+    }
+
+    SECTION("dormand prince")
+    {
+        ut::dormand_prince<oscillator_state> integrator{
+            .absolute_tolerance = { 1.0e-10 * ut::metre, 1.0e-10 * ut::metre_per_second },
+            .relative_tolerance = 1.0e-10
+        };
+
+        ut::time<double> t = 0.0 * ut::second;
+        oscillator_state y = initial;
+        REQUIRE( integrator.integrate( oscillator, t, y, end ) == ut::ode_status::ok );
+        REQUIRE( t.value == end.value );
+        REQUIRE_THAT( std::get<0>(y).in(ut::metre), WithinAbs(expected_x, 1e-8) );
+        REQUIRE_THAT( std::get<1>(y).in(ut::metre_per_second), WithinAbs(expected_v, 1e-8) );
+        REQUIRE( integrator.accepted_steps > 0 );
+
+        // looser tolerance needs fewer steps
+        ut::dormand_prince<oscillator_state> loose{
+            .absolute_tolerance = { 1.0e-4 * ut::metre, 1.0e-4 * ut::metre_per_second },
+            .relative_tolerance = 1.0e-4
+        };
+        t = 0.0 * ut::second;
+        y = initial;
+        REQUIRE( loose.integrate( oscillator, t, y, end ) == ut::ode_status::ok );
+        REQUIRE( loose.accepted_steps < integrator.accepted_steps );
+
+        // first same as last, six evaluations per accepted step after the first
+        std::size_t evaluations = 0;
+        const auto counted = [&]( ut::time<double> time, const oscillator_state& state ) { evaluations++; return oscillator( time, state ); };
+        ut::dormand_prince<oscillator_state> counting{ .absolute_tolerance = loose.absolute_tolerance, .relative_tolerance = 1.0e-4 };
+        t = 0.0 * ut::second;
+        y = initial;
+        REQUIRE( counting.integrate( counted, t, y, end ) == ut::ode_status::ok );
+        REQUIRE( evaluations == 1 + 6 * ( counting.accepted_steps + counting.rejected_steps ) );
+    }
+
+    SECTION("dormand prince non-finite error")
+    {
+        const auto undefined = []( ut::time<double>, const oscillator_state& ) {
+            return ut::derivative_of<oscillator_state>{ ut::speed<double>{ std::numeric_limits<double>::quiet_NaN() }, ut::acceleration<double>{ 0.0 } };
+        };
+
+        // the derivative is NaN beyond 1 s so no step can cross it
+        const auto singular = [&]( ut::time<double> time, const oscillator_state& state ) {
+            ut::derivative_of<oscillator_state> rate = oscillator( time, state );
+            if ( time > 1.0 * ut::second )
+                std::get<0>(rate).value = std::numeric_limits<double>::quiet_NaN();
+            return rate;
+        };
+
+        ut::dormand_prince<oscillator_state> integrator{
+            .absolute_tolerance = { 1.0e-6 * ut::metre, 1.0e-6 * ut::metre_per_second }
+        };
+        ut::time<double> t = 0.0 * ut::second;
+        oscillator_state y = initial;
+        REQUIRE( integrator.integrate( undefined, t, y, end ) == ut::ode_status::too_many_rejections );
+        REQUIRE( t.value == 0.0 );
+        REQUIRE( std::get<0>(y).value == 1.0 );
+        REQUIRE( integrator.rejected_steps == integrator.max_rejections );
+
+        y = initial;
+        REQUIRE( integrator.integrate( singular, t, y, end ) != ut::ode_status::ok );
+        REQUIRE( (t <= 1.0 * ut::second) );
+        REQUIRE( std::isfinite( std::get<0>(y).value ) );
+
+        ut::dormand_prince<oscillator_state> limited{
+            .absolute_tolerance = { 1.0e-6 * ut::metre, 1.0e-6 * ut::metre_per_second },
+            .min_dt = 1.0e-3 * ut::second
+        };
+        t = 0.0 * ut::second;
+        y = initial;
+        REQUIRE( limited.integrate( singular, t, y, end ) == ut::ode_status::step_underflow );
+        REQUIRE( (t <= 1.0 * ut::second) );
+    }
+
+    SECTION("ensemble")
+    {
+        const std::size_t count = 1001;
+        std::vector<ut::length<double>> x( count );
+        std::vector<ut::speed<double>> v( count );
+        for ( std::size_t i = 0; i < count; i++ )
+        {
+            x[i] = (1.0 + 0.001 * i) * ut::metre;
+            v[i] = 0.0 * ut::metre_per_second;
+        }
+        std::vector<ut::length<double>> x_threaded = x;
+        std::vector<ut::speed<double>> v_threaded = v;
+
+        using ensemble = ut::rk4_ensemble<ut::length<double>, ut::speed<double>>;
+        const auto derivative = []( ut::time<double>, ensemble::const_columns y, ensemble::derivative_columns dydt ) {
+            const auto [position, velocity] = y;
+            const auto [dx, dv] = dydt;
+            for ( std::size_t i = 0; i < position.size(); i++ )
+            {
+                dx[i] = velocity[i];
+                dv[i] = -(omega * omega) * position[i];
+            }
+        };
+
+        ensemble integrator;
+        ensemble threaded;
+        const ut::time<double> dt = 1.0e-3 * ut::second;
+        for ( int step = 0; step < 3000; step++ )
+        {
+            const ut::time<double> t = step * dt;
+            integrator.step( derivative, t, { std::span(x), std::span(v) }, dt );
+            threaded.step( derivative, t, { std::span(x_threaded), std::span(v_threaded) }, dt, 4 );
+        }
+
+        for ( std::size_t i = 0; i < count; i += 100 )
+        {
+            REQUIRE_THAT( x[i].in(ut::metre), WithinAbs((1.0 + 0.001 * i) * expected_x, 1e-9) );
+            REQUIRE( x[i].value == x_threaded[i].value );
+            REQUIRE( v[i].value == v_threaded[i].value );
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include <ut-units-random.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/catch_get_random_seed.hpp>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+template<typename Qty>
+static void sample_moments( std::span<const Qty> samples, double& mean, double& stddev )
+{
+    double sum = 0.0;
+    double sum2 = 0.0;
+    for ( const Qty& sample : samples )
+    {
+        sum += sample.value;
+        sum2 += sample.value * sample.value;
+    }
+    mean = sum / samples.size();
+    stddev = std::sqrt( sum2 / samples.size() - mean * mean );
+}
+
+TEST_CASE("Quantity Distributions", "[Random]")
+{
+    std::mt19937_64 generator( Catch::getSeed() );
+    double mean = 0.0;
+    double stddev = 0.0;
+
+    SECTION("splitmix64 fill matches operator()")
+    {
+        ut::splitmix64 a( 42 );
+        ut::splitmix64 b( 42 );
+        std::uint64_t bulk[37];
+        b.fill( bulk );
+        for ( std::uint64_t value : bulk )
+            REQUIRE( a() == value );
+        REQUIRE( a() == b() );
+    }
+
+    SECTION("uniform")
+    {
+        ut::uniform_qty_distribution<ut::speed<double>> wind( 0.0, 20.0, ut::knot );
+        REQUIRE_THAT( wind.max().in(ut::knot), WithinAbs(20.0, 1e-12) );
+
+        std::vector<ut::speed<double>> samples( 100000 );
+        wind.fill( generator, std::span( samples ) );
+        for ( const ut::speed<double>& sample : samples )
+        {
+            REQUIRE( sample.value >= wind.a().value );
+            REQUIRE( sample.value < wind.b().value );
+        }
+        sample_moments<ut::speed<double>>( samples, mean, stddev );
+        REQUIRE_THAT( mean, WithinAbs( (10.0 * ut::knot).value, 0.05 ) );
+
+        const ut::speed<double> single = wind( generator );
+        REQUIRE( single.in(ut::knot) < 20.0 );
+    }
+
+    SECTION("uniform offset units")
+    {
+        ut::uniform_qty_distribution<ut::temperature<double>> oat( -10.0, 30.0, ut::celsius );
+        REQUIRE_THAT( oat.min().in(ut::kelvin), WithinAbs(263.15, 1e-9) );
+        REQUIRE_THAT( oat.max().in(ut::kelvin), WithinAbs(303.15, 1e-9) );
+    }
+
+    SECTION("normal")
+    {
+        ut::normal_qty_distribution<ut::temperature<double>> oat( 15.0, 2.0, ut::celsius );
+        REQUIRE_THAT( oat.mean().in(ut::celsius), WithinAbs(15.0, 1e-9) );
+        REQUIRE_THAT( oat.stddev().in(ut::kelvin), WithinAbs(2.0, 1e-12) );
+
+        std::vector<ut::temperature<double>> samples( 100001 );
+        ut::splitmix64 fast( Catch::getSeed() );
+        oat.fill( fast, std::span( samples ) );
+        sample_moments<ut::temperature<double>>( samples, mean, stddev );
+        REQUIRE_THAT( mean, WithinAbs( 288.15, 0.05 ) );
+        REQUIRE_THAT( stddev, WithinAbs( 2.0, 0.05 ) );
+
+        // generators without 64 random bits fall back to the std distribution
+        std::mt19937 narrow( Catch::getSeed() );
+        oat.fill( narrow, std::span( samples ) );
+        sample_moments<ut::temperature<double>>( samples, mean, stddev );
+        REQUIRE_THAT( mean, WithinAbs( 288.15, 0.05 ) );
+        REQUIRE_THAT( stddev, WithinAbs( 2.0, 0.05 ) );
+    }
+
+    SECTION("float")
+    {
+        ut::normal_qty_distribution<ut::mass<float>> mass( 100.0 * ut::kilogram, 5.0 * ut::kilogram );
+        std::vector<ut::mass<float>> samples( 1001 );
+        mass.fill( generator, std::span( samples ) );
+        for ( const ut::mass<float>& sample : samples )
+            REQUIRE( std::isfinite( sample.value ) );
+
+        // double units are converted to the distribution's scalar type
+        ut::normal_qty_distribution<ut::mass<float>> scaled( 100.0f, 5.0f, ut::kilogram );
+        REQUIRE( scaled.mean().value == 100.0f );
+        REQUIRE( scaled.stddev().value == 5.0f );
+
+        ut::uniform_qty_distribution<ut::temperature<float>> oat( -10.0f, 30.0f, ut::celsius );
+        REQUIRE_THAT( oat.a().value, WithinRel(263.15f, 1e-6f) );
+        REQUIRE_THAT( oat.b().value, WithinRel(303.15f, 1e-6f) );
+
+        ut::normal_qty_distribution<ut::temperature<float>> offset( 15.0f, 2.0f, ut::celsius );
+        REQUIRE_THAT( offset.mean().value, WithinRel(288.15f, 1e-6f) );
+        REQUIRE( offset.stddev().value == 2.0f );
+    }
+}
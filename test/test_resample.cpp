@@ -0,0 +1,168 @@
+#include <ut-units-resample.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    constexpr double two_pi = 2.0 * std::numbers::pi;
+
+    // altitude oscillating at 0.5 Hz
+    ut::length<double> altitude( double t ) { return ( 1000.0 + 50.0 * std::sin( two_pi * 0.5 * t ) ) * ut::foot; }
+    // temperature ramp
+    ut::temperature<double> oat( double t ) { return ( 15.0 - 0.01 * t ) * ut::celsius; }
+    // speed with steps
+    ut::speed<double> ias( double t ) { return ( 100.0 + std::floor( t ) ) * ut::knot; }
+
+    using resampler = ut::resampler<ut::length<double>, ut::temperature<double>, ut::speed<double>>;
+
+    // 10 Hz altitude, 3 Hz temperature starting late, jittered ~50 Hz speed
+    void feed( resampler& r, double from, double to )
+    {
+        for ( int i = int( std::ceil( from * 10.0 ) ); i < to * 10.0; i++ )
+            r.channel<0>().push( ( 0.1 * i ) * ut::second, altitude( 0.1 * i ) );
+        for ( int i = int( std::ceil( ( from - 0.05 ) * 3.0 ) ); ( i / 3.0 + 0.05 ) < to; i++ )
+            if ( i >= 0 )
+                r.channel<1>().push( ( i / 3.0 + 0.05 ) * ut::second, oat( i / 3.0 + 0.05 ) );
+        for ( int i = int( std::ceil( from * 50.0 ) ); i < to * 50.0; i++ )
+        {
+            const double t = 0.02 * i + 0.004 * std::sin( 1.7 * i );
+            r.channel<2>().push( t * ut::second, ias( t ) );
+        }
+    }
+}
+
+TEST_CASE("Resampling", "[Resample]")
+{
+    const ut::frequency<double> rate = 20.0 * ut::hertz;
+
+    SECTION("Linear")
+    {
+        resampler r( rate );
+        feed( r, 0.0, 20.0 );
+
+        std::vector<ut::time<double>> times;
+        std::vector<ut::length<double>> h;
+        std::vector<ut::temperature<double>> temperature;
+        std::vector<ut::speed<double>> speed;
+        const std::size_t count = r.process( times, h, temperature, speed );
+
+        REQUIRE( count == times.size() );
+        REQUIRE( h.size() == count );
+        REQUIRE( speed.size() == count );
+        REQUIRE( count > 350 );
+        // starts at the first temperature sample
+        REQUIRE_THAT( times[0].in(ut::second), WithinAbs(0.05, 1e-12) );
+        for ( std::size_t k = 0; k < count; k++ )
+        {
+            REQUIRE_THAT( times[k].in(ut::second), WithinAbs(0.05 + k / 20.0, 1e-12) );
+            // linear data is reproduced exactly
+            REQUIRE_THAT( temperature[k].in(ut::celsius), WithinRel(oat( times[k].value ).in(ut::celsius), 1e-12) );
+            REQUIRE_THAT( h[k].in(ut::foot), WithinAbs(altitude( times[k].value ).in(ut::foot), 0.7) );
+        }
+        // buffered samples are dropped as they are used
+        REQUIRE( r.channel<0>().size() < 4 );
+    }
+
+    SECTION("Zero order hold")
+    {
+        resampler r( rate, ut::resample_mode::zero_order_hold );
+        feed( r, 0.0, 5.0 );
+
+        std::vector<ut::time<double>> times;
+        std::vector<ut::length<double>> h;
+        std::vector<ut::temperature<double>> temperature;
+        std::vector<ut::speed<double>> speed;
+        r.process( times, h, temperature, speed );
+
+        for ( std::size_t k = 0; k < times.size(); k++ )
+        {
+            int i = int( std::floor( times[k].value * 10.0 + 1e-6 ) );
+            i -= 0.1 * i > times[k].value ? 1 : 0;
+            REQUIRE( h[k].value == altitude( 0.1 * i ).value );
+            REQUIRE_THAT( speed[k].in(ut::knot), WithinAbs(100.0 + std::floor( times[k].value ), 1.0) );
+        }
+    }
+
+    SECTION("Windowed sinc")
+    {
+        resampler r( rate, ut::resample_mode::windowed_sinc );
+        feed( r, 0.0, 20.0 );
+
+        std::vector<ut::time<double>> times;
+        std::vector<ut::length<double>> h;
+        std::vector<ut::temperature<double>> temperature;
+        std::vector<ut::speed<double>> speed;
+        r.process( times, h, temperature, speed );
+        REQUIRE( times.size() > 300 );
+
+        // band limited, well clear of the start, the sinc is far closer than linear
+        for ( std::size_t k = 40; k < times.size(); k++ )
+        {
+            REQUIRE_THAT( h[k].in(ut::foot), WithinAbs(altitude( times[k].value ).in(ut::foot), 0.05) );
+            REQUIRE_THAT( temperature[k].in(ut::celsius), WithinAbs(oat( times[k].value ).in(ut::celsius), 1e-3) );
+        }
+        // the last outputs wait for half_width more samples of the 3 Hz channel
+        REQUIRE( times.back().value < 20.0 - 8.0 / 3.0 + 0.5 );
+    }
+
+    SECTION("Windowed sinc downsampling")
+    {
+        // 1 Hz wanted plus 30 Hz above the 10 Hz output Nyquist rate, sampled at 200 Hz
+        ut::resampler<ut::length<double>> r( rate, ut::resample_mode::windowed_sinc );
+        const auto signal = []( double t ) { return std::sin( two_pi * t ) + std::sin( two_pi * 30.0 * t ); };
+        for ( int i = 0; i < 4000; i++ )
+            r.channel<0>().push( ( 0.005 * i ) * ut::second, signal( 0.005 * i ) * ut::metre );
+
+        std::vector<ut::time<double>> times;
+        std::vector<ut::length<double>> x;
+        r.process( times, x );
+        REQUIRE( times.size() > 300 );
+        REQUIRE( r.channel<0>().taps >= 80 );
+        REQUIRE( r.channel<0>().taps <= 81 );
+
+        // taps spanning half_width output periods remove the 30 Hz alias
+        double worst = 0.0;
+        for ( std::size_t k = 40; k < times.size(); k++ )
+            worst = std::max( worst, std::abs( x[k].in(ut::metre) - std::sin( two_pi * times[k].value ) ) );
+        REQUIRE( worst < 0.01 );
+    }
+
+    SECTION("Incremental")
+    {
+        for ( const ut::resample_mode mode : { ut::resample_mode::zero_order_hold, ut::resample_mode::linear, ut::resample_mode::windowed_sinc } )
+        {
+            resampler whole( rate, mode );
+            resampler pieces( rate, mode );
+            feed( whole, 0.0, 30.0 );
+
+            std::vector<ut::time<double>> times, piece_times;
+            std::vector<ut::length<double>> h, piece_h;
+            std::vector<ut::temperature<double>> temperature, piece_temperature;
+            std::vector<ut::speed<double>> speed, piece_speed;
+            whole.process( times, h, temperature, speed );
+
+            for ( double t = 0.0; t < 30.0; t += 0.7 )
+            {
+                feed( pieces, t, std::min( t + 0.7, 30.0 ) );
+                pieces.process( piece_times, piece_h, piece_temperature, piece_speed );
+            }
+
+            REQUIRE( piece_times.size() == times.size() );
+            for ( std::size_t k = 0; k < times.size(); k++ )
+            {
+                REQUIRE( piece_times[k].value == times[k].value );
+                REQUIRE_THAT( piece_h[k].value, WithinRel(h[k].value, 1e-12) );
+                REQUIRE_THAT( piece_temperature[k].value, WithinRel(temperature[k].value, 1e-12) );
+                REQUIRE_THAT( piece_speed[k].value, WithinRel(speed[k].value, 1e-12) );
+            }
+        }
+    }
+}
@@ -0,0 +1,212 @@
+#include <ut-units-ring.h>
+#include <ut-units-chrono.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using sample = std::tuple<ut::time<double>, ut::pressure<double>>;
+
+    constexpr std::size_t transfer_count = 200000;
+
+    template<typename Ring>
+    void produce( Ring& ring, std::size_t producer, std::size_t count )
+    {
+        std::vector<ut::length<double>> batch;
+        for ( std::size_t i = 0; i < count; )
+        {
+            batch.clear();
+            for ( std::size_t j = 0; j < 1 + i % 7 && i + j < count; j++ )
+                batch.push_back( ut::length<double>{ double( producer * count + i + j ) } );
+
+            std::span<const ut::length<double>> remaining( batch );
+            while ( !remaining.empty() )
+            {
+                const std::size_t pushed = ring.push( remaining );
+                if ( pushed == 0 )
+                    std::this_thread::yield();
+                remaining = remaining.subspan( pushed );
+            }
+            i += batch.size();
+        }
+    }
+}
+
+TEST_CASE("Ring Buffers", "[Ring]")
+{
+    SECTION("spsc single thread")
+    {
+        ut::spsc_ring<sample> ring( 5 );
+        REQUIRE( ring.capacity() == 8 );
+        REQUIRE( ring.empty() );
+
+        // wraps around several times
+        double next_push = 0.0;
+        double next_pop = 0.0;
+        for ( int round = 0; round < 10; round++ )
+        {
+            while ( ring.push( sample{ ut::time<double>{ next_push }, 101325.0 * ut::pascal } ) )
+                next_push += 1.0;
+            REQUIRE( ring.size() == 8 );
+
+            sample value;
+            for ( int i = 0; i < 3; i++ )
+            {
+                REQUIRE( ring.pop( value ) );
+                REQUIRE( std::get<0>( value ).value == next_pop );
+                next_pop += 1.0;
+            }
+        }
+
+        std::vector<sample> out( 20 );
+        REQUIRE( ring.pop( out ) == 5 );
+        REQUIRE( std::get<0>( out[4] ).value == next_pop + 4.0 );
+        REQUIRE( std::get<1>( out[4] ).in(ut::pascal) == 101325.0 );
+        REQUIRE( ring.pop( out ) == 0 );
+    }
+
+    SECTION("spsc batch")
+    {
+        ut::spsc_ring<ut::speed<float>> ring( 16 );
+        std::vector<ut::speed<float>> in( 10 );
+        for ( std::size_t i = 0; i < in.size(); i++ )
+            in[i].value = float( i );
+
+        REQUIRE( ring.push( in ) == 10 );
+        REQUIRE( ring.push( in ) == 6 );
+
+        std::vector<ut::speed<float>> out( 12 );
+        REQUIRE( ring.pop( out ) == 12 );
+        REQUIRE( out[9].value == 9.0f );
+        REQUIRE( out[11].value == 1.0f );
+        REQUIRE( ring.size() == 4 );
+    }
+
+    SECTION("spsc threaded")
+    {
+        ut::spsc_ring<ut::length<double>> ring( 1024 );
+        std::jthread producer( [&] { produce( ring, 0, transfer_count ); } );
+
+        std::vector<ut::length<double>> out( 64 );
+        std::size_t received = 0;
+        bool ordered = true;
+        while ( received < transfer_count )
+        {
+            const std::size_t count = ring.pop( out );
+            if ( count == 0 )
+                std::this_thread::yield();
+            for ( std::size_t i = 0; i < count; i++ )
+                ordered &= out[i].value == double( received + i );
+            received += count;
+        }
+        REQUIRE( ordered );
+        REQUIRE( ring.empty() );
+    }
+
+    SECTION("mpsc threaded")
+    {
+        constexpr std::size_t producers = 4;
+        ut::mpsc_ring<ut::length<double>> ring( 256 );
+        {
+            std::vector<std::jthread> threads;
+            for ( std::size_t p = 0; p < producers; p++ )
+                threads.emplace_back( [&ring, p] { produce( ring, p, transfer_count / producers ); } );
+
+            std::vector<double> last( producers, -1.0 );
+            std::vector<ut::length<double>> out( 64 );
+            std::size_t received = 0;
+            bool ordered = true;
+            while ( received < transfer_count )
+            {
+                const std::size_t count = ring.pop( out );
+                if ( count == 0 )
+                    std::this_thread::yield();
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    const std::size_t p = std::size_t( out[i].value ) / ( transfer_count / producers );
+                    ordered &= p < producers && out[i].value > last[p];
+                    if ( p < producers )
+                        last[p] = out[i].value;
+                }
+                received += count;
+            }
+            REQUIRE( ordered );
+        }
+        REQUIRE( ring.empty() );
+    }
+}
+
+// Run with: ut-units-test "[benchmark]"
+TEST_CASE("Ring Buffer Benchmark", "[.][benchmark]")
+{
+    constexpr std::size_t count = 20000000;
+    std::vector<ut::length<double>> out( 256 );
+
+    const auto consume = [&]( auto& ring ) {
+        std::size_t received = 0;
+        while ( received < count )
+        {
+            const std::size_t popped = ring.pop( out );
+            if ( popped == 0 )
+                std::this_thread::yield();
+            received += popped;
+        }
+    };
+
+    for ( const std::size_t producers : { 1, 2, 4 } )
+    {
+        ut::time<double> elapsed;
+        {
+            ut::mpsc_ring<ut::length<double>> ring( 4096 );
+            ut::scoped_timer timer( elapsed );
+            std::vector<std::jthread> threads;
+            for ( std::size_t p = 0; p < producers; p++ )
+                threads.emplace_back( [&ring, p, producers] { produce( ring, p, count / producers ); } );
+            consume( ring );
+        }
+        std::printf( "mpsc %zu producers: %.1f Mitems/s, %.2f ns/item\n", producers,
+            count / elapsed.in(ut::second) * 1e-6, elapsed.in(ut::second) / count * 1e9 );
+    }
+
+    {
+        ut::time<double> elapsed;
+        {
+            ut::spsc_ring<ut::length<double>> ring( 4096 );
+            ut::scoped_timer timer( elapsed );
+            std::jthread producer( [&] { produce( ring, 0, count ); } );
+            consume( ring );
+        }
+        std::printf( "spsc: %.1f Mitems/s, %.2f ns/item\n",
+            count / elapsed.in(ut::second) * 1e-6, elapsed.in(ut::second) / count * 1e9 );
+    }
+
+    // round trip latency of single items between two threads
+    {
+        constexpr std::size_t round_trips = 200000;
+        ut::spsc_ring<ut::time<double>> request( 16 );
+        ut::spsc_ring<ut::time<double>> response( 16 );
+        std::jthread echo( [&] {
+            ut::time<double> value = 0.0 * ut::second;
+            for ( std::size_t i = 0; i < round_trips; i++ )
+            {
+                while ( !request.pop( value ) ) { std::this_thread::yield(); }
+                while ( !response.push( value ) ) { std::this_thread::yield(); }
+            }
+        } );
+
+        ut::time<double> elapsed;
+        {
+            ut::scoped_timer timer( elapsed );
+            ut::time<double> value = 0.0 * ut::second;
+            for ( std::size_t i = 0; i < round_trips; i++ )
+            {
+                while ( !request.push( value ) ) { std::this_thread::yield(); }
+                while ( !response.pop( value ) ) { std::this_thread::yield(); }
+            }
+        }
+        std::printf( "spsc one way latency: %.1f ns\n", elapsed.in(ut::second) / round_trips / 2.0 * 1e9 );
+    }
+}
@@ -0,0 +1,70 @@
+#include <ut-units-soa.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+
+struct soa_test_state
+{
+    ut::length<double> position;
+    ut::speed<double> velocity;
+    ut::mass<float> mass;
+    ut::temperature<double> temperature;
+};
+
+UT_UNITS_SOA_FIELDS(soa_test_state, position, velocity, mass, temperature);
+
+TEST_CASE("Struct of Arrays", "[SoA]")
+{
+    ut::soa<soa_test_state> states;
+    for ( int i = 0; i < 100; i++ )
+    {
+        states.push_back({
+            .position = double(i) * ut::metre,
+            .velocity = 2.0 * ut::metre_per_second,
+            .mass = float(i) * ut::kilogram.f(),
+            .temperature = 15.0 * ut::celsius
+        });
+    }
+
+    REQUIRE( states.size() == 100 );
+
+    SECTION("Columns")
+    {
+        static_assert( std::same_as<decltype(states.column<&soa_test_state::velocity>()), std::span<ut::speed<double>>> );
+        static_assert( std::same_as<decltype(states.column<&soa_test_state::mass>()), std::span<ut::mass<float>>> );
+
+        const std::span<ut::length<double>> position = states.column<&soa_test_state::position>();
+        const std::span<const ut::speed<double>> velocity = std::as_const(states).column<&soa_test_state::velocity>();
+        REQUIRE( reinterpret_cast<std::uintptr_t>(position.data()) % UT_UNITS_SOA_ALIGNMENT == 0 );
+        REQUIRE( reinterpret_cast<std::uintptr_t>(velocity.data()) % UT_UNITS_SOA_ALIGNMENT == 0 );
+
+        const ut::time<double> dt = 0.5 * ut::second;
+        for ( std::size_t i = 0; i < position.size(); i++ )
+            position[i] += velocity[i] * dt;
+
+        REQUIRE( states.load(10).position.in(ut::metre) == 11.0 );
+        REQUIRE( states.load(10).mass.in(ut::kilogram.f()) == 10.0f );
+    }
+
+    SECTION("Proxy references")
+    {
+        auto reference = states[5];
+        reference.get<&soa_test_state::velocity>() = 3.0 * ut::metre_per_second;
+        REQUIRE( states.column<&soa_test_state::velocity>()[5].in(ut::metre_per_second) == 3.0 );
+
+        soa_test_state state = states[7];
+        state.temperature = 20.0 * ut::celsius;
+        states[7] = state;
+        REQUIRE( std::as_const(states)[7].get<&soa_test_state::temperature>().in(ut::kelvin) == 293.15 );
+    }
+
+    SECTION("Resize and clear")
+    {
+        states.resize( 200 );
+        REQUIRE( states.column<&soa_test_state::mass>().size() == 200 );
+        REQUIRE( states.load(150).position.value == 0.0 );
+
+        states.clear();
+        REQUIRE( states.empty() );
+    }
+}
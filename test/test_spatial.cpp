@@ -0,0 +1,161 @@
+#include <ut-units-spatial.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+
+namespace
+{
+    using tree = ut::kd_tree<ut::length<double>>;
+
+    ut::length<double> distance( const tree::point_type& a, const tree::point_type& b )
+    {
+        return ut::sqrt( (a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]) );
+    }
+
+    std::vector<std::size_t> brute_within( const std::vector<tree::point_type>& points, const tree::point_type& centre, ut::length<double> radius )
+    {
+        std::vector<std::size_t> result;
+        for ( std::size_t i = 0; i < points.size(); i++ )
+            if ( distance( points[i], centre ).value <= radius.value )
+                result.push_back( i );
+        return result;
+    }
+
+    std::vector<std::size_t> sorted( std::vector<std::size_t> values )
+    {
+        std::sort( values.begin(), values.end() );
+        return values;
+    }
+}
+
+TEST_CASE("Spatial Index", "[Spatial]")
+{
+    std::mt19937_64 gen( 42 );
+    std::uniform_real_distribution<double> coordinate( -5000.0, 5000.0 );
+    std::vector<tree::point_type> points( 2000 );
+    for ( tree::point_type& point : points )
+        point = { coordinate(gen) * ut::metre, coordinate(gen) * ut::metre, 0.1 * coordinate(gen) * ut::foot };
+
+    const tree::point_type centre{ 100.0 * ut::metre, -200.0 * ut::metre, 0.0 * ut::metre };
+
+    SECTION("Radius query")
+    {
+        tree index;
+        index.build( points );
+        REQUIRE( index.size() == points.size() );
+
+        for ( const ut::length<double> radius : { 0.0 * ut::metre, 300.0 * ut::metre, 1.0 * ut::nautical_mile, 20.0 * ut::kilometre } )
+        {
+            std::vector<std::size_t> found;
+            index.within( centre, radius, found );
+            REQUIRE( sorted( found ) == brute_within( points, centre, radius ) );
+        }
+    }
+
+    SECTION("Nearest neighbours")
+    {
+        tree index;
+        index.build( points );
+
+        std::vector<tree::neighbour> found;
+        index.nearest( centre, 10, found );
+        REQUIRE( found.size() == 10 );
+
+        std::vector<double> expected;
+        for ( const tree::point_type& point : points )
+            expected.push_back( distance( point, centre ).value );
+        std::sort( expected.begin(), expected.end() );
+
+        for ( std::size_t i = 0; i < found.size(); i++ )
+        {
+            static_assert( std::same_as<decltype(found[i].distance), ut::length<double>> );
+            REQUIRE_THAT( found[i].distance.in(ut::metre), WithinRel(expected[i], 1e-12) );
+            REQUIRE_THAT( found[i].distance.in(ut::metre), WithinRel(distance( points[found[i].index], centre ).in(ut::metre), 1e-12) );
+        }
+
+        index.nearest( centre, 5000, found );
+        REQUIRE( found.size() == points.size() );
+    }
+
+    SECTION("Parallel build")
+    {
+        tree serial;
+        tree parallel;
+        serial.build( points );
+        parallel.build( points, 4 );
+        REQUIRE( serial.order == parallel.order );
+
+        std::vector<std::size_t> found;
+        parallel.within( centre, 1.0 * ut::kilometre, found );
+        REQUIRE( sorted( found ) == brute_within( points, centre, 1.0 * ut::kilometre ) );
+    }
+
+    SECTION("Moving points")
+    {
+        tree index;
+        index.build( points );
+
+        // small moves are refit without a rebuild
+        std::normal_distribution<double> step( 0.0, 5.0 );
+        for ( int frame = 0; frame < 3; frame++ )
+        {
+            for ( std::size_t i = 0; i < points.size(); i++ )
+            {
+                points[i][0] += step(gen) * ut::metre;
+                points[i][1] += step(gen) * ut::metre;
+                index.move( i, points[i] );
+            }
+            REQUIRE_FALSE( index.refit() );
+
+            std::vector<std::size_t> found;
+            index.within( centre, 500.0 * ut::metre, found );
+            REQUIRE( sorted( found ) == brute_within( points, centre, 500.0 * ut::metre ) );
+        }
+
+        // scattering every point degrades the leaf boxes and rebuilds
+        std::shuffle( points.begin(), points.end(), gen );
+        REQUIRE( index.update( points ) );
+
+        std::vector<std::size_t> found;
+        index.within( centre, 500.0 * ut::metre, found );
+        REQUIRE( sorted( found ) == brute_within( points, centre, 500.0 * ut::metre ) );
+    }
+
+    SECTION("Small and empty")
+    {
+        tree index;
+        std::vector<std::size_t> found;
+        std::vector<tree::neighbour> nearest;
+        index.build( {} );
+        index.within( centre, 1.0 * ut::metre, found );
+        index.nearest( centre, 3, nearest );
+        REQUIRE( found.empty() );
+        REQUIRE( nearest.empty() );
+
+        const std::vector<tree::point_type> three( points.begin(), points.begin() + 3 );
+        index.build( three );
+        index.nearest( three[1], 1, nearest );
+        REQUIRE( nearest[0].index == 1 );
+        REQUIRE( nearest[0].distance.value == 0.0 );
+
+        // refit before any build has nothing to fit
+        tree unbuilt;
+        REQUIRE_FALSE( unbuilt.refit() );
+
+        // a float tree takes a double radius
+        using float_point = ut::kd_tree<ut::length<float>>::point_type;
+        ut::kd_tree<ut::length<float>> floats;
+        const ut::length<float> zero{ 0.0f };
+        const std::vector<float_point> float_points{ { zero, zero, zero }, { ut::length<float>{ 3.0f }, zero, zero } };
+        floats.build( float_points );
+        found.clear();
+        floats.within( float_points[0], 2.0 * ut::metre, found );
+        REQUIRE( found == std::vector<std::size_t>{ 0 } );
+    }
+}
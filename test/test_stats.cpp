@@ -0,0 +1,142 @@
+#include <ut-units-stats.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using Catch::Matchers::WithinRel;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Streaming Statistics", "[Stats]")
+{
+    std::mt19937_64 generator( 42 );
+    std::lognormal_distribution<double> latency_distribution( -7.0, 0.5 );
+    std::vector<ut::time<double>> latencies;
+    for ( int i = 0; i < 10000; i++ )
+        latencies.push_back( latency_distribution( generator ) * ut::second );
+
+    double mean = 0.0;
+    for ( const ut::time<double>& latency : latencies )
+        mean += latency.value;
+    mean /= latencies.size();
+    double variance = 0.0;
+    for ( const ut::time<double>& latency : latencies )
+        variance += ( latency.value - mean ) * ( latency.value - mean );
+    variance /= latencies.size();
+
+    std::vector<double> sorted;
+    for ( const ut::time<double>& latency : latencies )
+        sorted.push_back( latency.value );
+    std::sort( sorted.begin(), sorted.end() );
+
+    SECTION("Result types")
+    {
+        static_assert( std::same_as<ut::stats<ut::length<double>>::variance_type, ut::area<double>> );
+        static_assert( std::same_as<decltype(ut::stats<ut::force<float>>{}.stddev()), ut::force<float>> );
+    }
+
+    SECTION("Moments and quantiles")
+    {
+        ut::stats<ut::time<double>> one_at_a_time;
+        for ( const ut::time<double>& latency : latencies )
+            one_at_a_time.add( latency );
+
+        ut::stats<ut::time<double>> batch;
+        batch.add( latencies );
+
+        for ( const ut::stats<ut::time<double>>* result : { &one_at_a_time, &batch } )
+        {
+            REQUIRE( result->count == latencies.size() );
+            REQUIRE_THAT( result->mean.in(ut::second), WithinRel(mean, 1e-12) );
+            REQUIRE_THAT( result->variance().in(ut::second * ut::second), WithinRel(variance, 1e-9) );
+            REQUIRE_THAT( result->stddev().in(ut::second), WithinRel(std::sqrt(variance), 1e-9) );
+            REQUIRE( result->minimum.value == sorted.front() );
+            REQUIRE( result->maximum.value == sorted.back() );
+            REQUIRE( result->quantile(0.0).value == sorted.front() );
+            REQUIRE( result->quantile(1.0).value == sorted.back() );
+            REQUIRE_THAT( result->quantile(0.5).in(ut::second), WithinRel(sorted[sorted.size() / 2], 0.01) );
+            REQUIRE_THAT( result->quantile(0.99).in(ut::second), WithinRel(sorted[sorted.size() * 99 / 100], 0.011) );
+        }
+    }
+
+    SECTION("Merge")
+    {
+        ut::stats<ut::time<double>> total;
+        total.add( latencies );
+
+        ut::stats<ut::time<double>> first;
+        ut::stats<ut::time<double>> second;
+        first.add( std::span( latencies ).first( 3000 ) );
+        second.add( std::span( latencies ).subspan( 3000 ) );
+        first.merge( second );
+
+        REQUIRE( first.count == total.count );
+        REQUIRE_THAT( first.mean.in(ut::second), WithinRel(total.mean.in(ut::second), 1e-12) );
+        REQUIRE_THAT( first.variance().in(ut::second * ut::second), WithinRel(total.variance().in(ut::second * ut::second), 1e-12) );
+        REQUIRE( first.quantile(0.5).value == total.quantile(0.5).value );
+        REQUIRE( first.quantile(0.99).value == total.quantile(0.99).value );
+
+        ut::stats<ut::time<double>> empty;
+        first.merge( empty );
+        REQUIRE( first.count == total.count );
+    }
+
+    SECTION("Signed values and offset units")
+    {
+        ut::stats<ut::temperature<double>> temperatures;
+        for ( int i = -50; i <= 50; i++ )
+            temperatures.add( double(i) * ut::celsius );
+        REQUIRE_THAT( temperatures.mean.in(ut::celsius), WithinAbs(0.0, 1e-9) );
+        REQUIRE_THAT( temperatures.sample_variance().in(ut::kelvin * ut::kelvin), WithinRel(858.5, 1e-12) );
+
+        ut::stats<ut::force<double>> loads;
+        for ( int i = -100; i <= 100; i++ )
+            loads.add( double(i) * ut::newton );
+        REQUIRE_THAT( loads.quantile(0.25).in(ut::newton), WithinRel(-50.0, 0.01) );
+        REQUIRE_THAT( loads.quantile(0.5).in(ut::newton), WithinAbs(0.0, 1e-12) );
+        REQUIRE_THAT( loads.quantile(0.75).in(ut::newton), WithinRel(50.0, 0.01) );
+    }
+
+    SECTION("Bucket limit")
+    {
+        ut::quantile_sketch<ut::length<double>> sketch( 0.01, 64 );
+        for ( int i = -20; i <= 20; i++ )
+            sketch.add( std::pow( 10.0, i ) * ut::metre );
+        REQUIRE( sketch.count() == 41 );
+        REQUIRE( sketch.positive.counts.size() <= 64 );
+        REQUIRE_THAT( sketch.quantile(1.0).in(ut::metre), WithinRel(1e20, 0.01) );
+    }
+
+    SECTION("Infinity and NaN")
+    {
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+        std::vector<ut::length<double>> values;
+        for ( int i = 1; i <= 8; i++ )
+            values.push_back( double(i) * ut::metre );
+        values.push_back( ut::length<double>{ infinity } );
+        values.push_back( ut::length<double>{ -infinity } );
+        values.push_back( ut::length<double>{ std::numeric_limits<double>::quiet_NaN() } );
+
+        ut::quantile_sketch<ut::length<double>> sketch;
+        sketch.add( values );
+        for ( const ut::length<double> value : values )
+            sketch.add( value );
+
+        REQUIRE( sketch.count() == 20 );
+        REQUIRE( sketch.nan_count == 2 );
+        REQUIRE( sketch.quantile(0.0).value == -infinity );
+        REQUIRE( sketch.quantile(1.0).value == infinity );
+        REQUIRE_THAT( sketch.quantile(0.5).in(ut::metre), WithinRel(4.0, 0.02) );
+
+        ut::quantile_sketch<ut::length<double>> merged;
+        merged.merge( sketch );
+        REQUIRE( merged.count() == 20 );
+        REQUIRE( merged.nan_count == 2 );
+        merged.clear();
+        REQUIRE( merged.count() == 0 );
+        REQUIRE( merged.nan_count == 0 );
+    }
+}